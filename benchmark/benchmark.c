@@ -0,0 +1,720 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include "../outubro/aula_10_10/codigos/util.h"
+#include "../outubro/aula_10_10/codigos/rede_ordenacao.h"
+#include "motores.h"
+#include "contadores.h"
+
+/*
+    Driver unificado de benchmark dos labs de ordenacao:
+    - Liga todos os motores (byron.c, tiroNoEscuro.c, tiroNoEscuro_otimizado.c, rascunho.c e o shaker sort do voltaUSP)
+    - Percorre a grade tamanhos x distribuicoes x motores, repetindo cada medicao --repeticoes vezes
+    - Cada repeticao ordena uma copia nova da entrada; geracao, copia, verificacao e hash ficam fora do tempo
+    - Tempo de parede com clock_gettime(CLOCK_MONOTONIC); emite mediana, p95, media e desvio padrao
+
+    Distribuicoes:
+    - int:       sorted, reverse, random (get_random semente 12345 em [1..n]), fewunique (16 valores), sawtooth
+    - Brinquedo: best, average, worst (mesma construcao de inputGenerator.py)
+
+    Compilacao (a partir da raiz do repositorio):
+        gcc -O2 -pthread benchmark/motores_*.c benchmark/benchmark.c -o benchmark/benchmark -lm
+    Uso:
+        ./benchmark/benchmark [--tamanhos 1000,10000,100000] [--repeticoes 5] [--motores tiro,byron.merge]
+                              [--distribuicoes random,best] [--limite-quadratico 20000] [--json] [--saida arquivo]
+    O CSV/JSON inclui o hash da saida ordenada: dois motores (ou duas versoes) corretos devem concordar.
+    --contadores acrescenta a mediana de cada contador de hardware (perf_event_open, ver contadores.h).
+    --crc <MB> mede a vazao (GB/s) do CRC32 de util.h em cada caminho: byte a byte, slice-by-8 e PCLMULQDQ.
+    --aleatorio <n> compara get_random (x % max) e get_random_lemire (multiply-shift): vazao do shuffle de
+    bogosort.c sobre n elementos e teste qui-quadrado de uniformidade de cada mapeamento.
+    --generico <n> compara, por tipo (int, long, QueryPair, Brinquedo), o qsort com comparador por callback
+    (motores "*.qsort*") com as instancias de ordenacao_generica.h (motores "*generico*") em entradas aleatorias.
+    --rede <blocos> mede o cutoff isolado: ordena <blocos> blocos aleatorios de 8, 16, 24 (pdqsort) e 32 ints
+    (runs do mergesort, radix MSD, cauda do heapsort) com insertion sort e com as redes de rede_ordenacao.h
+    (escalar e AVX2). Os motores "*_rede" da grade usam as redes dentro dos algoritmos completos.
+*/
+
+#define MAX_REPETICOES 1000
+
+static const Motor *tabelas[] = { motores_tiro, motores_otimizado, motores_rascunho, motores_voltausp, motores_byron,
+                                  motores_novembro };
+
+static const char *dist_int[] = { "sorted", "reverse", "random", "fewunique", "sawtooth" };
+static const char *dist_brinquedo[] = { "best", "average", "worst" };
+
+typedef struct {
+    double mediana, p95, media, desvio, minimo;
+} Estatisticas;
+
+// Relogio de parede monotonico em segundos
+static double agora_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static int cmp_int64(const void *a, const void *b) {
+    int64_t x = *(const int64_t *)a, y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Mediana por contador entre as repeticoes (um contador indisponivel fica -1 em todas)
+static LeituraHW mediana_contadores(LeituraHW *leituras, int k) {
+    LeituraHW m;
+    int64_t col[MAX_REPETICOES];
+
+    for (int c = 0; c < CONTADORES_NUM; c++) {
+        for (int r = 0; r < k; r++)
+            col[r] = leituras[r].valor[c];
+
+        qsort(col, (size_t)k, sizeof(int64_t), cmp_int64);
+        m.valor[c] = col[k / 2];
+    }
+
+    return m;
+}
+
+// Ordena 'amostras' e calcula as estatisticas (p95 por posto mais proximo; desvio amostral)
+static Estatisticas calcular_estatisticas(double *amostras, int k) {
+    Estatisticas e;
+    qsort(amostras, (size_t)k, sizeof(double), cmp_double);
+
+    e.minimo = amostras[0];
+    e.mediana = (k & 1) ? amostras[k / 2] : 0.5 * (amostras[k / 2 - 1] + amostras[k / 2]);
+
+    int posto = (int)ceil(0.95 * k) - 1;
+    e.p95 = amostras[posto < 0 ? 0 : posto];
+
+    double soma = 0.0;
+    for (int i = 0; i < k; i++)
+        soma += amostras[i];
+    e.media = soma / k;
+
+    double quad = 0.0;
+    for (int i = 0; i < k; i++)
+        quad += (amostras[i] - e.media) * (amostras[i] - e.media);
+    e.desvio = (k > 1) ? sqrt(quad / (k - 1)) : 0.0;
+
+    return e;
+}
+
+// Gera entradas de int; retorna 0 se a distribuicao nao existe
+static int gerar_int(int *v, int n, const char *dist) {
+    int seed = 12345;
+
+    if (strcmp(dist, "sorted") == 0)
+        for (int i = 0; i < n; i++) v[i] = i + 1;
+
+    else if (strcmp(dist, "reverse") == 0)
+        for (int i = 0; i < n; i++) v[i] = n - i;
+
+    else if (strcmp(dist, "random") == 0)
+        for (int i = 0; i < n; i++) v[i] = get_random(&seed, n);
+
+    else if (strcmp(dist, "fewunique") == 0)
+        for (int i = 0; i < n; i++) v[i] = get_random(&seed, 16);
+
+    else if (strcmp(dist, "sawtooth") == 0) {
+        // 16 "dentes" crescentes de mesmo tamanho
+        int periodo = n / 16 > 0 ? n / 16 : 1;
+        for (int i = 0; i < n; i++) v[i] = i % periodo + 1;
+    }
+
+    else
+        return 0;
+
+    return 1;
+}
+
+static int int_ordenado(const int *v, int n) {
+    for (int i = 1; i < n; i++)
+        if (v[i - 1] > v[i])
+            return 0;
+
+    return 1;
+}
+
+// CRC32 byte a byte (implementacao original de util.h), referencia para os caminhos rapidos
+static uint32_t crc32_byte(uint32_t crc, const void *buf, size_t size) {
+    const unsigned char *p = (const unsigned char *)buf;
+    crc = crc ^ ~0U;
+    while (size--)
+        crc = crc32_table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    return crc ^ ~0U;
+}
+
+static uint32_t crc32_via_slice8(uint32_t crc, const void *buf, size_t size) {
+    return crc32_slice8(crc ^ ~0U, (const unsigned char *)buf, size) ^ ~0U;
+}
+
+// Vazao de cada caminho do CRC32 sobre 'mb' MiB; todos devem imprimir o mesmo hash
+static int executar_bench_crc(long mb, int repeticoes, FILE *out) {
+    size_t bytes = (size_t)mb << 20;
+    unsigned char *buf = (unsigned char *)malloc(bytes ? bytes : 1);
+    if (!buf) {
+        fprintf(stderr, "Erro de alocacao de memoria.\n");
+        return 1;
+    }
+
+    int seed = 12345;
+    for (size_t i = 0; i < bytes; i++)
+        buf[i] = (unsigned char)get_random(&seed, 256);
+
+    struct { const char *nome; uint32_t (*f)(uint32_t, const void *, size_t); int usa_clmul; } caminhos[] = {
+        { "byte", crc32_byte, 0 },
+        { "slice8", crc32_via_slice8, 0 },
+        { "clmul", crc32, 1 },          // crc32() com PCLMULQDQ habilitado
+    };
+
+    double amostras[MAX_REPETICOES];
+    int disponivel = crc32_usa_clmul;
+    fprintf(out, "caminho,bytes,repeticoes,mediana_s,gbps,crc32\n");
+
+    for (size_t c = 0; c < sizeof(caminhos) / sizeof(caminhos[0]); c++) {
+        if (caminhos[c].usa_clmul && !disponivel) {
+            fprintf(stderr, "PCLMULQDQ indisponivel nesta CPU: caminho clmul ignorado.\n");
+            continue;
+        }
+
+        uint32_t h = 0;
+        for (int r = 0; r < repeticoes; r++) {
+            double t0 = agora_s();
+            h = caminhos[c].f(0, buf, bytes);
+            amostras[r] = agora_s() - t0;
+        }
+
+        Estatisticas e = calcular_estatisticas(amostras, repeticoes);
+        fprintf(out, "%s,%zu,%d,%.6f,%.3f,%08X\n", caminhos[c].nome, bytes, repeticoes,
+                e.mediana, e.mediana > 0 ? (double)bytes / e.mediana / 1e9 : 0.0, h);
+    }
+
+    free(buf);
+    return 0;
+}
+
+typedef int (*SorteioFn)(int *, int);
+
+// Embaralhamento igual ao shuffle de bogosort.c (j em [0..i-1]: algoritmo de Sattolo, so gera ciclos),
+// instanciado por variante para que o sorteio seja inlinado como no programa original
+#define DEFINE_SHUFFLE(nome, sorteio)                          \
+    static void nome(int *v, int n, int *seed) {               \
+        for (int i = n - 1; i >= 1; i--) {                     \
+            int j = sorteio(seed, i) - 1, temp = v[i];         \
+            v[i] = v[j];                                       \
+            v[j] = temp;                                       \
+        }                                                      \
+    }
+
+DEFINE_SHUFFLE(shuffle_modulo, get_random)
+DEFINE_SHUFFLE(shuffle_lemire, get_random_lemire)
+
+// Qui-quadrado de 'amostras' sorteios em [1..max] agrupados em k classes de mesma probabilidade
+// (max multiplo de k). Limite critico a 0.1% pela aproximacao de Wilson-Hilferty (z = 3.09).
+static void teste_uniformidade(FILE *out, const char *nome, SorteioFn sorteio, int max, int k, long amostras) {
+    long *obs = (long *)calloc((size_t)k, sizeof(long));
+    if (!obs) {
+        fprintf(stderr, "Erro de alocacao de memoria.\n");
+        return;
+    }
+
+    int seed = 12345;
+    long por_classe = max / k;
+    for (long a = 0; a < amostras; a++)
+        obs[(sorteio(&seed, max) - 1) / por_classe]++;
+
+    double esperado = (double)amostras / k, qui2 = 0;
+    for (int c = 0; c < k; c++)
+        qui2 += (obs[c] - esperado) * (obs[c] - esperado) / esperado;
+
+    double gl = k - 1, t = 2.0 / (9.0 * gl);
+    double critico = gl * pow(1.0 - t + 3.09 * sqrt(t), 3);
+    fprintf(out, "%s,%d,%d,%ld,%.2f,%.2f,%s\n", nome, max, k, amostras, qui2, critico,
+            qui2 <= critico ? "uniforme" : "rejeitado");
+    free(obs);
+}
+
+// Shuffle (vazao) e uniformidade dos dois mapeamentos de util.h
+static int executar_bench_aleatorio(long n, int repeticoes, FILE *out) {
+    int *v = (int *)malloc((size_t)n * sizeof(int));
+    if (!v) {
+        fprintf(stderr, "Erro de alocacao de memoria.\n");
+        return 1;
+    }
+
+    struct { const char *nome; SorteioFn f; void (*shuffle)(int *, int, int *); } variantes[] = {
+        { "modulo", get_random, shuffle_modulo },
+        { "lemire", get_random_lemire, shuffle_lemire },
+    };
+    const int nvar = (int)(sizeof(variantes) / sizeof(variantes[0]));
+    double amostras[MAX_REPETICOES];
+
+    fprintf(out, "variante,n,repeticoes,mediana_s,ns_por_elemento,permutacoes_por_s,crc32\n");
+    for (int c = 0; c < nvar; c++) {
+        for (long i = 0; i < n; i++)
+            v[i] = (int)i + 1;
+
+        int seed = 12345;
+        for (int r = 0; r < repeticoes; r++) {
+            double t0 = agora_s();
+            variantes[c].shuffle(v, (int)n, &seed);
+            amostras[r] = agora_s() - t0;
+        }
+
+        Estatisticas e = calcular_estatisticas(amostras, repeticoes);
+        fprintf(out, "%s,%ld,%d,%.6f,%.3f,%.1f,%08X\n", variantes[c].nome, n, repeticoes, e.mediana,
+                e.mediana * 1e9 / (double)n, e.mediana > 0 ? 1.0 / e.mediana : 0.0,
+                crc32(0, v, (size_t)n * sizeof(int)));
+    }
+
+    // max = 3 * 2^29: 2^32 mod max = 2^30, entao x % max cai nas 2/3 iniciais com 1.5x a probabilidade;
+    // max = 6 (um dado) tem vies de ~1e-9, invisivel mesmo para o modulo
+    fprintf(out, "\nvariante,max,classes,amostras,qui2,critico_0.1%%,resultado\n");
+    for (int c = 0; c < nvar; c++) {
+        teste_uniformidade(out, variantes[c].nome, variantes[c].f, 3 << 29, 12, 1200000);
+        teste_uniformidade(out, variantes[c].nome, variantes[c].f, 6, 6, 6000000);
+    }
+
+    // O shuffle de Sattolo gera so os 24 ciclos de 5 elementos, todos com a mesma frequencia;
+    // qualquer permutacao fora disso conta como erro
+    fprintf(out, "\nvariante,ciclos,amostras,fora_dos_ciclos,qui2,critico_0.1%%,resultado\n");
+    for (int c = 0; c < nvar; c++) {
+        long obs[120] = {0}, total = 1200000, fora = 0;
+        int seed = 12345;
+
+        for (long a = 0; a < total; a++) {
+            int p[5] = {0, 1, 2, 3, 4};
+            variantes[c].shuffle(p, 5, &seed);
+
+            int tam_ciclo = 1;
+            for (int x = p[0]; x != 0; x = p[x])
+                tam_ciclo++;
+            if (tam_ciclo != 5) {
+                fora++;
+                continue;
+            }
+
+            // Indice lexicografico da permutacao (codigo de Lehmer)
+            int idx = 0;
+            for (int i = 0; i < 5; i++) {
+                int menores = 0;
+                for (int j = i + 1; j < 5; j++)
+                    menores += p[j] < p[i];
+                idx = idx * (5 - i) + menores;
+            }
+            obs[idx]++;
+        }
+
+        // Classes = os 24 ciclos (indices com alguma ocorrencia possivel); os demais ficaram em 'fora'
+        double esperado = (double)total / 24, qui2 = 0;
+        int classes = 0;
+        for (int i = 0; i < 120; i++) {
+            if (obs[i] == 0)
+                continue;
+            classes++;
+            qui2 += (obs[i] - esperado) * (obs[i] - esperado) / esperado;
+        }
+        qui2 += (24 - classes) * esperado; // ciclo que nunca saiu
+
+        double gl = 23, t = 2.0 / (9.0 * gl), critico = gl * pow(1.0 - t + 3.09 * sqrt(t), 3);
+        fprintf(out, "%s,24,%ld,%ld,%.2f,%.2f,%s\n", variantes[c].nome, total, fora, qui2, critico,
+                (fora == 0 && qui2 <= critico) ? "uniforme" : "rejeitado");
+    }
+
+    free(v);
+    return 0;
+}
+
+static const char *nomes_familia[] = { "int", "brinquedo", "long", "query" };
+
+static size_t tamanho_elemento(int familia) {
+    if (familia == FAMILIA_INT)
+        return sizeof(int);
+    if (familia == FAMILIA_BRINQUEDO)
+        return byron_tamanho_elemento();
+    return novembro_tamanho_elemento(familia);
+}
+
+// qsort (callback) x ordenacao_generica.h (comparador inlinado): mediana e ganho sobre o qsort do mesmo tipo
+static int executar_bench_generico(long n, int repeticoes, FILE *out) {
+    size_t maior = 0;
+    for (int f = FAMILIA_INT; f <= FAMILIA_CONSULTA; f++)
+        if (tamanho_elemento(f) > maior)
+            maior = tamanho_elemento(f);
+
+    void *original = malloc((size_t)n * maior), *trabalho = malloc((size_t)n * maior);
+    if (!original || !trabalho) {
+        fprintf(stderr, "Erro de alocacao de memoria.\n");
+        free(original);
+        free(trabalho);
+        return 1;
+    }
+
+    double amostras[MAX_REPETICOES];
+    int falhas = 0;
+    fprintf(out, "tipo,motor,n,repeticoes,mediana_s,ns_por_elemento,ganho_sobre_qsort,ok\n");
+    for (int f = FAMILIA_INT; f <= FAMILIA_CONSULTA; f++) {
+        size_t bytes = (size_t)n * tamanho_elemento(f);
+        if (f == FAMILIA_INT)
+            gerar_int((int *)original, (int)n, "random");
+        else if (f == FAMILIA_BRINQUEDO)
+            byron_gerar(original, (int)n, "average");
+        else
+            novembro_gerar(f, original, (int)n);
+
+        double referencia = 0.0; // mediana do qsort deste tipo (a tabela lista o qsort antes das instancias)
+        for (size_t t = 0; t < sizeof(tabelas) / sizeof(tabelas[0]); t++) {
+            for (const Motor *m = tabelas[t]; m->nome; m++) {
+                int eh_qsort = strstr(m->nome, ".qsort") != NULL;
+                if (m->familia != f || m->quadratico || (!eh_qsort && !strstr(m->nome, "generico")))
+                    continue;
+
+                for (int r = 0; r < repeticoes; r++) {
+                    memcpy(trabalho, original, bytes);
+                    double t0 = agora_s();
+                    m->ordenar(trabalho, (int)n);
+                    amostras[r] = agora_s() - t0;
+                }
+
+                int ok = f == FAMILIA_INT ? int_ordenado((const int *)trabalho, (int)n)
+                       : f == FAMILIA_BRINQUEDO ? byron_verificar(trabalho, (int)n)
+                       : novembro_verificar(f, trabalho, (int)n);
+                falhas += !ok;
+
+                Estatisticas e = calcular_estatisticas(amostras, repeticoes);
+                if (eh_qsort)
+                    referencia = e.mediana;
+                fprintf(out, "%s,%s,%ld,%d,%.6f,%.2f,%.2f,%d\n", nomes_familia[f], m->nome, n, repeticoes, e.mediana,
+                        e.mediana * 1e9 / (double)n, referencia > 0 && e.mediana > 0 ? referencia / e.mediana : 0.0, ok);
+            }
+        }
+    }
+
+    free(original);
+    free(trabalho);
+    return falhas ? 2 : 0;
+}
+
+// Insertion sort em v[0..n), igual ao cutoff dos labs de outubro
+static void insercao_bloco(int *v, int n) {
+    for (int i = 1; i < n; i++) {
+        int x = v[i], j = i - 1;
+        while (j >= 0 && v[j] > x) {
+            v[j + 1] = v[j];
+            j--;
+        }
+        v[j + 1] = x;
+    }
+}
+
+static void rede_bloco_escalar(int *v, int n) { rede_ordenar_com(v, n, 0); }
+static void rede_bloco_avx2(int *v, int n) { rede_ordenar_com(v, n, 1); }
+
+// Cutoff isolado: insertion sort x redes de ordenacao em blocos independentes de cada tamanho de cutoff
+static int executar_bench_rede(long blocos, int repeticoes, FILE *out) {
+    int *original = (int *)malloc((size_t)blocos * REDE_MAXIMO * sizeof(int));
+    int *trabalho = (int *)malloc((size_t)blocos * REDE_MAXIMO * sizeof(int));
+    if (!original || !trabalho) {
+        fprintf(stderr, "Erro de alocacao de memoria.\n");
+        free(original);
+        free(trabalho);
+        return 1;
+    }
+
+    struct { const char *nome; void (*f)(int *, int); int usa_avx2; } variantes[] = {
+        { "insercao", insercao_bloco, 0 },
+        { "rede_escalar", rede_bloco_escalar, 0 },
+        { "rede_avx2", rede_bloco_avx2, 1 },
+    };
+    const int tamanhos_corte[] = { 8, 16, 24, 32 };
+    int disponivel = 0;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    disponivel = rede_usa_avx2();
+#endif
+    if (!disponivel)
+        fprintf(stderr, "AVX2 indisponivel nesta CPU: variante rede_avx2 ignorada.\n");
+
+    double amostras[MAX_REPETICOES];
+    int falhas = 0;
+    fprintf(out, "tamanho,variante,blocos,repeticoes,mediana_s,ns_por_bloco,ganho_sobre_insercao,crc32\n");
+    for (size_t t = 0; t < sizeof(tamanhos_corte) / sizeof(tamanhos_corte[0]); t++) {
+        int m = tamanhos_corte[t];
+        size_t total = (size_t)blocos * (size_t)m;
+        int seed = 12345;
+        for (size_t i = 0; i < total; i++)
+            original[i] = get_random(&seed, 1 << 30);
+
+        double referencia = 0.0;
+        uint32_t crc_referencia = 0;
+        for (size_t c = 0; c < sizeof(variantes) / sizeof(variantes[0]); c++) {
+            if (variantes[c].usa_avx2 && !disponivel)
+                continue;
+
+            for (int r = 0; r < repeticoes; r++) {
+                memcpy(trabalho, original, total * sizeof(int));
+                double t0 = agora_s();
+                for (size_t b = 0; b < total; b += (size_t)m)
+                    variantes[c].f(trabalho + b, m);
+                amostras[r] = agora_s() - t0;
+            }
+
+            // Todas as variantes devem produzir exatamente os mesmos blocos
+            uint32_t h = crc32(0, trabalho, total * sizeof(int));
+            for (size_t b = 0; b < total; b += (size_t)m)
+                falhas += !int_ordenado(trabalho + b, m);
+            if (c == 0)
+                crc_referencia = h;
+            falhas += h != crc_referencia;
+
+            Estatisticas e = calcular_estatisticas(amostras, repeticoes);
+            if (c == 0)
+                referencia = e.mediana;
+            fprintf(out, "%d,%s,%ld,%d,%.6f,%.2f,%.2f,%08X\n", m, variantes[c].nome, blocos, repeticoes, e.mediana,
+                    e.mediana * 1e9 / (double)blocos, referencia > 0 && e.mediana > 0 ? referencia / e.mediana : 0.0, h);
+        }
+    }
+
+    if (falhas)
+        fprintf(stderr, "ERRO: %d bloco(s) fora de ordem ou com hash divergente.\n", falhas);
+
+    free(original);
+    free(trabalho);
+    return falhas ? 2 : 0;
+}
+
+// Verifica se 'nome' casa com algum item da lista "a,b,c" (prefixo; "all" casa com tudo)
+static int casa_lista(const char *lista, const char *nome) {
+    if (lista == NULL || strcmp(lista, "all") == 0)
+        return 1;
+
+    const char *p = lista;
+    while (*p) {
+        const char *fim = strchr(p, ',');
+        size_t len = fim ? (size_t)(fim - p) : strlen(p);
+
+        if (len > 0 && strncmp(nome, p, len) == 0)
+            return 1;
+
+        if (!fim)
+            break;
+        p = fim + 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    const char *tamanhos = "1000,10000,100000";
+    const char *filtro_motores = "all", *filtro_dist = "all", *saida = NULL;
+    int repeticoes = 5, limite_quadratico = 20000, json = 0, usar_contadores = 0;
+    long crc_mb = 0, aleatorio_n = 0, generico_n = 0, rede_blocos = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--tamanhos") == 0 && i + 1 < argc) tamanhos = argv[++i];
+        else if (strcmp(argv[i], "--repeticoes") == 0 && i + 1 < argc) repeticoes = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--motores") == 0 && i + 1 < argc) filtro_motores = argv[++i];
+        else if (strcmp(argv[i], "--distribuicoes") == 0 && i + 1 < argc) filtro_dist = argv[++i];
+        else if (strcmp(argv[i], "--limite-quadratico") == 0 && i + 1 < argc) limite_quadratico = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--saida") == 0 && i + 1 < argc) saida = argv[++i];
+        else if (strcmp(argv[i], "--json") == 0) json = 1;
+        else if (strcmp(argv[i], "--contadores") == 0) usar_contadores = 1;
+        else if (strcmp(argv[i], "--crc") == 0 && i + 1 < argc) crc_mb = atol(argv[++i]);
+        else if (strcmp(argv[i], "--aleatorio") == 0 && i + 1 < argc) aleatorio_n = atol(argv[++i]);
+        else if (strcmp(argv[i], "--generico") == 0 && i + 1 < argc) generico_n = atol(argv[++i]);
+        else if (strcmp(argv[i], "--rede") == 0 && i + 1 < argc) rede_blocos = atol(argv[++i]);
+        else {
+            fprintf(stderr, "Opcao desconhecida: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (repeticoes < 1 || repeticoes > MAX_REPETICOES) {
+        fprintf(stderr, "--repeticoes deve estar em [1..%d].\n", MAX_REPETICOES);
+        return 1;
+    }
+
+    FILE *out = saida ? fopen(saida, "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "Erro ao abrir arquivo de saida: %s\n", saida);
+        return 1;
+    }
+
+    init_crc32();
+
+    if (crc_mb > 0) {
+        int rc = executar_bench_crc(crc_mb, repeticoes, out);
+        if (saida)
+            fclose(out);
+        return rc;
+    }
+
+    if (aleatorio_n > 0) {
+        int rc = executar_bench_aleatorio(aleatorio_n, repeticoes, out);
+        if (saida)
+            fclose(out);
+        return rc;
+    }
+
+    if (generico_n > 0) {
+        int rc = executar_bench_generico(generico_n, repeticoes, out);
+        if (saida)
+            fclose(out);
+        return rc;
+    }
+
+    if (rede_blocos > 0) {
+        int rc = executar_bench_rede(rede_blocos, repeticoes, out);
+        if (saida)
+            fclose(out);
+        return rc;
+    }
+
+    // Maior tamanho da grade dimensiona os buffers uma unica vez
+    long nmax = 0;
+    for (const char *p = tamanhos; *p; ) {
+        char *fim;
+        long n = strtol(p, &fim, 10);
+        if (fim == p) break;
+        if (n > nmax) nmax = n;
+        p = (*fim == ',') ? fim + 1 : fim;
+    }
+
+    size_t elem = sizeof(int) > byron_tamanho_elemento() ? sizeof(int) : byron_tamanho_elemento();
+    void *original = malloc((size_t)(nmax > 0 ? nmax : 1) * elem);
+    void *trabalho = malloc((size_t)(nmax > 0 ? nmax : 1) * elem);
+    if (!original || !trabalho) {
+        fprintf(stderr, "Erro de alocacao de memoria.\n");
+        return 1;
+    }
+
+    double amostras[MAX_REPETICOES];
+    static LeituraHW leituras[MAX_REPETICOES];
+    int primeiro = 1, falhas = 0;
+
+    ContadoresHW contadores;
+    contadores_abrir(&contadores);
+
+    if (json)
+        fprintf(out, "[\n");
+    else {
+        fprintf(out, "motor,distribuicao,n,repeticoes,mediana_s,p95_s,media_s,desvio_s,min_s,hash,ok");
+        if (usar_contadores) {
+            fprintf(out, ",");
+            contadores_cabecalho_csv(out);
+        }
+        fprintf(out, "\n");
+    }
+
+    for (const char *p = tamanhos; *p; ) {
+        char *fim;
+        int n = (int)strtol(p, &fim, 10);
+        if (fim == p) break;
+        p = (*fim == ',') ? fim + 1 : fim;
+
+        for (size_t t = 0; t < sizeof(tabelas) / sizeof(tabelas[0]); t++) {
+            for (const Motor *m = tabelas[t]; m->nome; m++) {
+                if (!casa_lista(filtro_motores, m->nome))
+                    continue;
+
+                if (m->quadratico && n > limite_quadratico)
+                    continue;
+
+                if (m->familia != FAMILIA_INT && m->familia != FAMILIA_BRINQUEDO)
+                    continue; // long e QueryPair: so no --generico
+
+                int familia_int = m->familia == FAMILIA_INT;
+                const char **dists = familia_int ? dist_int : dist_brinquedo;
+                int ndists = familia_int ? (int)(sizeof(dist_int) / sizeof(dist_int[0]))
+                                         : (int)(sizeof(dist_brinquedo) / sizeof(dist_brinquedo[0]));
+                size_t bytes = (size_t)n * (familia_int ? sizeof(int) : byron_tamanho_elemento());
+
+                for (int d = 0; d < ndists; d++) {
+                    if (!casa_lista(filtro_dist, dists[d]))
+                        continue;
+
+                    if (familia_int)
+                        gerar_int((int *)original, n, dists[d]);
+                    else
+                        byron_gerar(original, n, dists[d]);
+
+                    // Repeticoes: copia nova a cada rodada, fora da regiao cronometrada
+                    for (int r = 0; r < repeticoes; r++) {
+                        memcpy(trabalho, original, bytes);
+                        if (usar_contadores)
+                            contadores_iniciar(&contadores);
+
+                        double t0 = agora_s();
+                        m->ordenar(trabalho, n);
+                        amostras[r] = agora_s() - t0;
+
+                        if (usar_contadores)
+                            contadores_parar(&contadores, &leituras[r]);
+                    }
+
+                    int ok = familia_int ? int_ordenado((const int *)trabalho, n) : byron_verificar(trabalho, n);
+                    unsigned hash = familia_int ? crc32(0, trabalho, bytes) : byron_hash(trabalho, n);
+                    Estatisticas e = calcular_estatisticas(amostras, repeticoes);
+
+                    if (!ok) {
+                        fprintf(stderr, "Saida fora de ordem: %s em %s (n=%d)\n", m->nome, dists[d], n);
+                        falhas++;
+                    }
+
+                    LeituraHW hw = usar_contadores ? mediana_contadores(leituras, repeticoes) : (LeituraHW){ { 0 } };
+
+                    if (json) {
+                        fprintf(out, "%s  {\"motor\": \"%s\", \"distribuicao\": \"%s\", \"n\": %d, \"repeticoes\": %d, "
+                                     "\"mediana_s\": %.9f, \"p95_s\": %.9f, \"media_s\": %.9f, \"desvio_s\": %.9f, "
+                                     "\"min_s\": %.9f, \"hash\": \"%08X\", \"ok\": %s",
+                                primeiro ? "" : ",\n", m->nome, dists[d], n, repeticoes,
+                                e.mediana, e.p95, e.media, e.desvio, e.minimo, hash, ok ? "true" : "false");
+
+                        // Contadores indisponiveis viram null
+                        for (int c = 0; usar_contadores && c < CONTADORES_NUM; c++) {
+                            if (hw.valor[c] < 0)
+                                fprintf(out, ", \"%s\": null", contadores_nomes[c]);
+                            else
+                                fprintf(out, ", \"%s\": %lld", contadores_nomes[c], (long long)hw.valor[c]);
+                        }
+
+                        fprintf(out, "}");
+                    }
+
+                    else {
+                        fprintf(out, "%s,%s,%d,%d,%.9f,%.9f,%.9f,%.9f,%.9f,%08X,%d",
+                                m->nome, dists[d], n, repeticoes,
+                                e.mediana, e.p95, e.media, e.desvio, e.minimo, hash, ok);
+                        if (usar_contadores) {
+                            fprintf(out, ",");
+                            contadores_imprimir_csv(out, &hw);
+                        }
+                        fprintf(out, "\n");
+                    }
+
+                    primeiro = 0;
+                    fflush(out);
+                }
+            }
+        }
+    }
+
+    if (json)
+        fprintf(out, "\n]\n");
+
+    contadores_fechar(&contadores);
+
+    if (saida)
+        fclose(out);
+
+    free(original);
+    free(trabalho);
+
+    return falhas ? 2 : 0;
+}
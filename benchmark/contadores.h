@@ -0,0 +1,149 @@
+#ifndef CONTADORES_H
+#define CONTADORES_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+    contadores.h
+    - Contadores de hardware via perf_event_open (Linux): ciclos, instrucoes, branch-misses,
+      falhas de leitura na L1d e na LLC.
+    - Uso: contadores_abrir -> (contadores_iniciar; regiao medida; contadores_parar) ... -> contadores_fechar.
+    - Cada evento tem seu proprio descritor (sem grupo), para que um evento nao suportado nao derrube os demais;
+      quando o kernel multiplexa, o valor e escalado por tempo habilitado / tempo em execucao.
+    - Fora do Linux, ou sem permissao (perf_event_paranoid), os valores saem como -1 ("NA" na impressao).
+*/
+
+#define CONTADORES_NUM 5
+
+static const char *contadores_nomes[CONTADORES_NUM] = {
+    "ciclos", "instrucoes", "branch_misses", "l1d_misses", "llc_misses"
+};
+
+typedef struct {
+    int fd[CONTADORES_NUM];
+} ContadoresHW;
+
+typedef struct {
+    int64_t valor[CONTADORES_NUM]; // -1 quando o evento nao esta disponivel
+} LeituraHW;
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+static inline int contadores_abrir_evento(uint32_t tipo, uint64_t config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = tipo;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1; // mede so o espaco de usuario (funciona com perf_event_paranoid = 2)
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static inline void contadores_abrir(ContadoresHW *c) {
+    const uint64_t l1d = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+    c->fd[0] = contadores_abrir_evento(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    c->fd[1] = contadores_abrir_evento(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    c->fd[2] = contadores_abrir_evento(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    c->fd[3] = contadores_abrir_evento(PERF_TYPE_HW_CACHE, l1d);
+    c->fd[4] = contadores_abrir_evento(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+}
+
+static inline void contadores_iniciar(ContadoresHW *c) {
+    for (int i = 0; i < CONTADORES_NUM; i++) {
+        if (c->fd[i] < 0)
+            continue;
+
+        ioctl(c->fd[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(c->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+static inline void contadores_parar(ContadoresHW *c, LeituraHW *l) {
+    for (int i = 0; i < CONTADORES_NUM; i++)
+        if (c->fd[i] >= 0)
+            ioctl(c->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+
+    for (int i = 0; i < CONTADORES_NUM; i++) {
+        uint64_t buf[3]; // valor, tempo habilitado, tempo em execucao
+        l->valor[i] = -1;
+
+        if (c->fd[i] < 0 || read(c->fd[i], buf, sizeof(buf)) != (ssize_t)sizeof(buf))
+            continue;
+
+        if (buf[2] == 0)
+            l->valor[i] = 0; // evento nunca entrou na PMU (regiao curta demais)
+        else if (buf[2] < buf[1])
+            l->valor[i] = (int64_t)((double)buf[0] * (double)buf[1] / (double)buf[2]);
+        else
+            l->valor[i] = (int64_t)buf[0];
+    }
+}
+
+static inline void contadores_fechar(ContadoresHW *c) {
+    for (int i = 0; i < CONTADORES_NUM; i++) {
+        if (c->fd[i] >= 0)
+            close(c->fd[i]);
+        c->fd[i] = -1;
+    }
+}
+
+#else
+
+static inline void contadores_abrir(ContadoresHW *c) {
+    for (int i = 0; i < CONTADORES_NUM; i++)
+        c->fd[i] = -1;
+}
+
+static inline void contadores_iniciar(ContadoresHW *c) {
+    (void)c;
+}
+
+static inline void contadores_parar(ContadoresHW *c, LeituraHW *l) {
+    (void)c;
+    for (int i = 0; i < CONTADORES_NUM; i++)
+        l->valor[i] = -1;
+}
+
+static inline void contadores_fechar(ContadoresHW *c) {
+    (void)c;
+}
+
+#endif
+
+// Cabecalho CSV das colunas dos contadores (sem virgula inicial)
+static inline void contadores_cabecalho_csv(FILE *f) {
+    for (int i = 0; i < CONTADORES_NUM; i++)
+        fprintf(f, "%s%s", i ? "," : "", contadores_nomes[i]);
+
+    fprintf(f, ",ipc");
+}
+
+// Valores em CSV; "NA" para indisponiveis. IPC = instrucoes / ciclos indica se o codigo e limitado
+// por desvios/memoria (IPC baixo com muitos misses) ou por computacao (IPC alto)
+static inline void contadores_imprimir_csv(FILE *f, const LeituraHW *l) {
+    for (int i = 0; i < CONTADORES_NUM; i++) {
+        if (l->valor[i] < 0)
+            fprintf(f, "%sNA", i ? "," : "");
+        else
+            fprintf(f, "%s%lld", i ? "," : "", (long long)l->valor[i]);
+    }
+
+    if (l->valor[0] > 0 && l->valor[1] >= 0)
+        fprintf(f, ",%.3f", (double)l->valor[1] / (double)l->valor[0]);
+    else
+        fprintf(f, ",NA");
+}
+
+#endif
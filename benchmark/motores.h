@@ -0,0 +1,47 @@
+#ifndef MOTORES_H
+#define MOTORES_H
+
+#include <stddef.h>
+
+/*
+    motores.h
+    - Interface comum entre o driver de benchmark e os "motores" de ordenacao dos labs.
+    - Cada arquivo motores_*.c inclui o .c original de um lab (renomeando main e os simbolos de util.h
+      por macros, para que varios labs convivam no mesmo executavel) e exporta uma tabela de Motor.
+*/
+
+// Familia do elemento ordenado: define quais distribuicoes de entrada se aplicam ao motor
+enum {
+    FAMILIA_INT = 0,        // vetores de int (tiroNoEscuro, rascunho, voltaUSP, somasBinario)
+    FAMILIA_BRINQUEDO = 1,  // vetores de Brinquedo (byron.c)
+    FAMILIA_LONG = 2,       // datas yyyymmdd em long (curto.c); so no modo --generico
+    FAMILIA_CONSULTA = 3    // QueryPair (curto.c), ordenados pela chave; so no modo --generico
+};
+
+typedef struct {
+    const char *nome;                   // "lab.algoritmo", usado no CSV/JSON e no filtro --motores
+    int familia;                        // FAMILIA_*
+    int quadratico;                     // 1 se O(n^2): pulado acima de --limite-quadratico
+    void (*ordenar)(void *v, int n);    // ordena v[0..n-1] in-place
+} Motor;
+
+// Tabelas terminadas por um Motor com nome NULL
+extern const Motor motores_tiro[];
+extern const Motor motores_otimizado[];
+extern const Motor motores_rascunho[];
+extern const Motor motores_voltausp[];
+extern const Motor motores_byron[];
+extern const Motor motores_novembro[];
+
+// Elementos Brinquedo sao opacos para o driver: tamanho, geracao, verificacao e hash ficam em motores_byron.c
+size_t byron_tamanho_elemento(void);
+int byron_gerar(void *v, int n, const char *distribuicao); // retorna 0 se a distribuicao nao existe
+int byron_verificar(const void *v, int n);                 // 1 se v esta na ordem de compararBrinquedos
+unsigned byron_hash(const void *v, int n);                 // CRC32 da sequencia de ids
+
+// long e QueryPair de curto.c: tamanho, geracao (datas aleatorias) e verificacao ficam em motores_novembro.c
+size_t novembro_tamanho_elemento(int familia);
+void novembro_gerar(int familia, void *v, int n);
+int novembro_verificar(int familia, const void *v, int n);
+
+#endif
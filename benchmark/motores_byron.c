@@ -0,0 +1,127 @@
+// Motores de setembro/aula_26_09/codigos/byron.c (ordenacaoVia*) e geracao das entradas de Brinquedo
+#define main byron_main
+#include "../setembro/aula_26_09/codigos/byron.c"
+
+#include <stdint.h>
+#include "motores.h"
+
+static void bubble(void *v, int n) { ordenacaoViaBubbleSort((Brinquedo *)v, n); }
+static void insertion(void *v, int n) { ordenacaoViaInsertionSort((Brinquedo *)v, n); }
+static void merge(void *v, int n) { ordenacaoViaMergeSort((Brinquedo *)v, 0, n - 1); }
+static void quick(void *v, int n) { ordenacaoViaQuickSort((Brinquedo *)v, 0, n - 1); }
+static void radix(void *v, int n) { ordenacaoViaRadixSort((Brinquedo *)v, n); }
+static void indices(void *v, int n) { ordenacaoViaIndices((Brinquedo *)v, n); }
+static void soa(void *v, int n) { ordenacaoViaSoA((Brinquedo *)v, n); }
+static void timsort(void *v, int n) { ordenacaoViaTimSort((Brinquedo *)v, n); }
+static void introsort(void *v, int n) { ordenacaoViaIntroSort((Brinquedo *)v, n); }
+static void paralelo(void *v, int n) { ordenacaoViaMergeSortParalelo((Brinquedo *)v, n, 0); }
+
+// Referencia por callback (como os qsort de curto.c e somasBinario.c) e as instancias de ordenacao_generica.h
+static int compararBrinquedosQsort(const void *a, const void *b) {
+    return compararBrinquedos((const Brinquedo *)a, (const Brinquedo *)b);
+}
+
+#ifndef ORDENACAO_GENERICA // com a flag, byron.c já instancia o Brinquedo (método 9)
+#define ORDENACAO_TIPO Brinquedo
+#define ORDENACAO_SUFIXO brinquedo
+#define ORDENACAO_MENOR(a, b) (compararBrinquedos((a), (b)) < 0)
+#include "ordenacao_generica.h"
+#endif
+
+static void qsort_callback(void *v, int n) { qsort(v, (size_t)n, sizeof(Brinquedo), compararBrinquedosQsort); }
+static void generico_intro(void *v, int n) { introsort_brinquedo((Brinquedo *)v, n); }
+static void generico_merge(void *v, int n) { mergesort_brinquedo((Brinquedo *)v, n); }
+static void generico_heap(void *v, int n) { heapsort_brinquedo((Brinquedo *)v, n); }
+
+const Motor motores_byron[] = {
+    { "byron.bubble",    FAMILIA_BRINQUEDO, 1, bubble },
+    { "byron.insertion", FAMILIA_BRINQUEDO, 1, insertion },
+    { "byron.merge",     FAMILIA_BRINQUEDO, 0, merge },
+    { "byron.quick",     FAMILIA_BRINQUEDO, 1, quick }, // pivo no ultimo elemento: O(n^2) em best/worst
+    { "byron.radix",     FAMILIA_BRINQUEDO, 0, radix },
+    { "byron.indices",   FAMILIA_BRINQUEDO, 0, indices },
+    { "byron.soa",       FAMILIA_BRINQUEDO, 0, soa }, // inclui a conversao AoS -> SoA -> AoS
+    { "byron.timsort",   FAMILIA_BRINQUEDO, 0, timsort },
+    { "byron.introsort", FAMILIA_BRINQUEDO, 0, introsort },
+    { "byron.paralelo",  FAMILIA_BRINQUEDO, 0, paralelo }, // um thread por nucleo
+    { "byron.qsort",     FAMILIA_BRINQUEDO, 0, qsort_callback },
+    { "byron.generico_intro", FAMILIA_BRINQUEDO, 0, generico_intro },
+    { "byron.generico_merge", FAMILIA_BRINQUEDO, 0, generico_merge },
+    { "byron.generico_heap",  FAMILIA_BRINQUEDO, 0, generico_heap },
+    { NULL, 0, 0, NULL }
+};
+
+size_t byron_tamanho_elemento(void) {
+    return sizeof(Brinquedo);
+}
+
+// Mesma sequencia de setembro/aula_26_09/codigos/inputGenerator.py:
+// por cor (na ordem da lista), comprimento 0.1, 0.2, ... e nota 10..1 em cada comprimento
+int byron_gerar(void *v, int n, const char *distribuicao) {
+    static const char *cores[] = { "amarelo", "azul", "branco", "rosa", "preto", "verde", "vermelho" };
+    Brinquedo *b = (Brinquedo *)v;
+
+    // Cada cor recebe 'por_cor' linhas (multiplo de 10), como em fileGenerator(max_middle_value)
+    int por_cor = ((n + 6) / 7 + 9) / 10 * 10;
+    if (por_cor == 0)
+        por_cor = 10;
+
+    int best = strcmp(distribuicao, "best") == 0;
+    int worst = strcmp(distribuicao, "worst") == 0;
+    int average = strcmp(distribuicao, "average") == 0;
+
+    if (!best && !worst && !average)
+        return 0;
+
+    int total = 7 * por_cor;
+    uint32_t estado = 12345;
+
+    for (int i = 0; i < n; i++) {
+        // best: linhas em ordem; worst: linhas de tras para frente; average: sorteio com reposicao
+        int linha = i;
+        if (worst)
+            linha = total - 1 - i;
+
+        else if (average) {
+            estado ^= estado << 13;
+            estado ^= estado >> 17;
+            estado ^= estado << 5;
+            linha = (int)(estado % (uint32_t)total);
+        }
+
+        b[i].id = i;
+        strcpy(b[i].cor, cores[linha / por_cor]);
+        b[i].comprimento = (double)((linha % por_cor) / 10 + 1) / 10.0;
+        b[i].nota = (double)(10 - linha % 10);
+    }
+
+    // postos das cores, como na leitura de byron.c (fora da regiao cronometrada)
+    return internarCores(b, n) ? 1 : 0;
+}
+
+int byron_verificar(const void *v, int n) {
+    const Brinquedo *b = (const Brinquedo *)v;
+
+    for (int i = 1; i < n; i++)
+        if (compararBrinquedos(&b[i - 1], &b[i]) > 0)
+            return 0;
+
+    return 1;
+}
+
+unsigned byron_hash(const void *v, int n) {
+    // CRC32 refletido (0xEDB88320) bit a bit dos ids; so roda fora da regiao cronometrada
+    const Brinquedo *b = (const Brinquedo *)v;
+    uint32_t crc = ~0U;
+
+    for (int i = 0; i < n; i++) {
+        const unsigned char *p = (const unsigned char *)&b[i].id;
+        for (size_t k = 0; k < sizeof(int); k++) {
+            crc ^= p[k];
+            for (int j = 0; j < 8; j++)
+                crc = (crc & 1) ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+        }
+    }
+
+    return crc ^ ~0U;
+}
@@ -0,0 +1,94 @@
+// Motores de novembro: qsort com callback de curto.c (compare_longs, compare_query_pair) e somasBinario.c
+// (cmpInt), contra as instancias de ordenacao_generica.h com o mesmo criterio inlinado (modo --generico)
+#define main curto_main
+#include "../novembro/aula_11_07/codigos/curto.c"
+#undef main
+#define main somas_main
+#include "../novembro/aula_11_21/codigos/somasBinario.c"
+#undef main
+
+#include <stdint.h>
+#include "motores.h"
+
+#define ORDENACAO_TIPO int
+#define ORDENACAO_SUFIXO int
+#define ORDENACAO_MENOR(a, b) (*(a) < *(b))
+#include "ordenacao_generica.h"
+
+#define ORDENACAO_TIPO long
+#define ORDENACAO_SUFIXO long
+#define ORDENACAO_MENOR(a, b) (*(a) < *(b))
+#include "ordenacao_generica.h"
+
+#define ORDENACAO_TIPO QueryPair
+#define ORDENACAO_SUFIXO query
+#define ORDENACAO_MENOR(a, b) ((a)->key < (b)->key)
+#include "ordenacao_generica.h"
+
+static void qsort_int(void *v, int n) { qsort(v, (size_t)n, sizeof(int), cmpInt); }
+static void intro_int(void *v, int n) { introsort_int((int *)v, n); }
+static void merge_int(void *v, int n) { mergesort_int((int *)v, n); }
+static void heap_int(void *v, int n) { heapsort_int((int *)v, n); }
+static void insercao_int_motor(void *v, int n) { insercao_int((int *)v, n); }
+
+static void qsort_long(void *v, int n) { qsort(v, (size_t)n, sizeof(long), compare_longs); }
+static void intro_long(void *v, int n) { introsort_long((long *)v, n); }
+static void merge_long(void *v, int n) { mergesort_long((long *)v, n); }
+static void heap_long(void *v, int n) { heapsort_long((long *)v, n); }
+
+static void qsort_query(void *v, int n) { qsort(v, (size_t)n, sizeof(QueryPair), compare_query_pair); }
+static void intro_query(void *v, int n) { introsort_query((QueryPair *)v, n); }
+static void merge_query(void *v, int n) { mergesort_query((QueryPair *)v, n); }
+static void heap_query(void *v, int n) { heapsort_query((QueryPair *)v, n); }
+
+const Motor motores_novembro[] = {
+    { "somas.qsort",            FAMILIA_INT,      0, qsort_int },
+    { "generico.intro_int",     FAMILIA_INT,      0, intro_int },
+    { "generico.merge_int",     FAMILIA_INT,      0, merge_int },
+    { "generico.heap_int",      FAMILIA_INT,      0, heap_int },
+    { "generico.insercao_int",  FAMILIA_INT,      1, insercao_int_motor },
+    { "curto.qsort_long",       FAMILIA_LONG,     0, qsort_long },
+    { "generico.intro_long",    FAMILIA_LONG,     0, intro_long },
+    { "generico.merge_long",    FAMILIA_LONG,     0, merge_long },
+    { "generico.heap_long",     FAMILIA_LONG,     0, heap_long },
+    { "curto.qsort_query",      FAMILIA_CONSULTA, 0, qsort_query },
+    { "generico.intro_query",   FAMILIA_CONSULTA, 0, intro_query },
+    { "generico.merge_query",   FAMILIA_CONSULTA, 0, merge_query },
+    { "generico.heap_query",    FAMILIA_CONSULTA, 0, heap_query },
+    { NULL, 0, 0, NULL }
+};
+
+size_t novembro_tamanho_elemento(int familia) {
+    return familia == FAMILIA_CONSULTA ? sizeof(QueryPair) : sizeof(long);
+}
+
+// Datas yyyymmdd sorteadas (xorshift32, semente fixa) entre 1990 e 2025, como as entradas de curto.c
+void novembro_gerar(int familia, void *v, int n) {
+    uint32_t estado = 12345;
+
+    for (int i = 0; i < n; i++) {
+        estado ^= estado << 13;
+        estado ^= estado >> 17;
+        estado ^= estado << 5;
+        long data = (long)(1990 + estado % 36) * 10000L + (long)(1 + (estado >> 8) % 12) * 100L +
+                    (long)(1 + (estado >> 16) % 28);
+
+        if (familia == FAMILIA_CONSULTA) {
+            ((QueryPair *)v)[i].key = data;
+            ((QueryPair *)v)[i].idx = i;
+        }
+        else
+            ((long *)v)[i] = data;
+    }
+}
+
+int novembro_verificar(int familia, const void *v, int n) {
+    for (int i = 1; i < n; i++) {
+        long anterior = familia == FAMILIA_CONSULTA ? ((const QueryPair *)v)[i - 1].key : ((const long *)v)[i - 1];
+        long atual = familia == FAMILIA_CONSULTA ? ((const QueryPair *)v)[i].key : ((const long *)v)[i];
+        if (anterior > atual)
+            return 0;
+    }
+
+    return 1;
+}
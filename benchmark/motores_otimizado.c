@@ -0,0 +1,36 @@
+// Motores de outubro/aula_10_10/codigos/tiroNoEscuro_otimizado.c (IDs 1..4)
+#define main otimizado_main
+#define crc32_table otimizado_crc32_table
+#define init_crc32 otimizado_init_crc32
+#define crc32 otimizado_crc32
+#define get_random otimizado_get_random
+#define algoritmo_id1_quicksort otimizado_id1_quicksort
+#define algoritmo_id2_mergesort otimizado_id2_mergesort
+#define algoritmo_id3_heapsort otimizado_id3_heapsort
+#define algoritmo_id4_pdqsort otimizado_id4_pdqsort
+#include "../outubro/aula_10_10/codigos/tiroNoEscuro_otimizado.c"
+
+#include "motores.h"
+
+static void id1(void *v, int n) { otimizado_id1_quicksort((int *)v, n); }
+static void id2(void *v, int n) { otimizado_id2_mergesort((int *)v, n); }
+static void id3(void *v, int n) { otimizado_id3_heapsort((int *)v, n); }
+static void id4(void *v, int n) { otimizado_id4_pdqsort((int *)v, n); }
+
+// Mesmos hibridos com o cutoff em redes de ordenacao (opcao --rede do programa)
+static void id1_rede(void *v, int n) { usar_rede = 1; otimizado_id1_quicksort((int *)v, n); usar_rede = 0; }
+static void id2_rede(void *v, int n) { usar_rede = 1; otimizado_id2_mergesort((int *)v, n); usar_rede = 0; }
+static void id3_rede(void *v, int n) { usar_rede = 1; otimizado_id3_heapsort((int *)v, n); usar_rede = 0; }
+static void id4_rede(void *v, int n) { usar_rede = 1; otimizado_id4_pdqsort((int *)v, n); usar_rede = 0; }
+
+const Motor motores_otimizado[] = {
+    { "otimizado.id1_quicksort", FAMILIA_INT, 0, id1 },
+    { "otimizado.id2_mergesort", FAMILIA_INT, 0, id2 },
+    { "otimizado.id3_heapsort",  FAMILIA_INT, 0, id3 },
+    { "otimizado.id4_pdqsort",   FAMILIA_INT, 0, id4 },
+    { "otimizado.id1_quicksort_rede", FAMILIA_INT, 0, id1_rede },
+    { "otimizado.id2_mergesort_rede", FAMILIA_INT, 0, id2_rede },
+    { "otimizado.id3_heapsort_rede",  FAMILIA_INT, 0, id3_rede },
+    { "otimizado.id4_pdqsort_rede",   FAMILIA_INT, 0, id4_rede },
+    { NULL, 0, 0, NULL }
+};
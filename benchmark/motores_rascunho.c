@@ -0,0 +1,30 @@
+// Motores de outubro/aula_10_10/codigos/rascunho.c (IDs 1..4)
+#define main rascunho_main
+#define crc32_table rascunho_crc32_table
+#define init_crc32 rascunho_init_crc32
+#define crc32 rascunho_crc32
+#define get_random rascunho_get_random
+#define algoritmo_id1_quicksort rascunho_id1_quicksort
+#define algoritmo_id2_mergesort rascunho_id2_mergesort
+#define algoritmo_id3_heapsort rascunho_id3_heapsort
+#define algoritmo_id4_blockmerge rascunho_id4_blockmerge
+#include "../outubro/aula_10_10/codigos/rascunho.c"
+
+#include "motores.h"
+
+static void id1(void *v, int n) { rascunho_id1_quicksort((int *)v, n); }
+static void id2(void *v, int n) { rascunho_id2_mergesort((int *)v, n); }
+static void id3(void *v, int n) { rascunho_id3_heapsort((int *)v, n); }
+static void id4(void *v, int n) { rascunho_id4_blockmerge((int *)v, n); }
+
+// Quicksort com o cutoff em redes de ordenacao (opcao --rede do programa)
+static void id1_rede(void *v, int n) { usar_rede = 1; rascunho_id1_quicksort((int *)v, n); usar_rede = 0; }
+
+const Motor motores_rascunho[] = {
+    { "rascunho.id1_quicksort", FAMILIA_INT, 0, id1 },
+    { "rascunho.id2_mergesort", FAMILIA_INT, 0, id2 },
+    { "rascunho.id3_heapsort",  FAMILIA_INT, 0, id3 },
+    { "rascunho.id4_blockmerge", FAMILIA_INT, 0, id4 },
+    { "rascunho.id1_quicksort_rede", FAMILIA_INT, 0, id1_rede },
+    { NULL, 0, 0, NULL }
+};
@@ -0,0 +1,40 @@
+// Motores de outubro/aula_10_10/codigos/tiroNoEscuro.c (IDs 1..5)
+#define main tiro_main
+#define crc32_table tiro_crc32_table
+#define init_crc32 tiro_init_crc32
+#define crc32 tiro_crc32
+#define get_random tiro_get_random
+#define algoritmo_id1_quicksort tiro_id1_quicksort
+#define algoritmo_id2_radixsort tiro_id2_radixsort
+#define algoritmo_id3_introsort tiro_id3_introsort
+#define algoritmo_id3_introsort_paralelo tiro_id3_introsort_paralelo
+#define algoritmo_id4_radixsort_lsd tiro_id4_radixsort_lsd
+#define algoritmo_id5_pdqsort tiro_id5_pdqsort
+#include "../outubro/aula_10_10/codigos/tiroNoEscuro.c"
+
+#include "motores.h"
+
+static void id1(void *v, int n) { tiro_id1_quicksort((int *)v, n); }
+static void id2(void *v, int n) { tiro_id2_radixsort((int *)v, n); }
+static void id3(void *v, int n) { tiro_id3_introsort((int *)v, n); }
+static void id4(void *v, int n) { tiro_id4_radixsort_lsd((int *)v, n); }
+static void id5(void *v, int n) { tiro_id5_pdqsort((int *)v, n); }
+
+// Mesmos hibridos com o cutoff em redes de ordenacao (opcao --rede do programa)
+static void id1_rede(void *v, int n) { usar_rede = 1; tiro_id1_quicksort((int *)v, n); usar_rede = 0; }
+static void id2_rede(void *v, int n) { usar_rede = 1; tiro_id2_radixsort((int *)v, n); usar_rede = 0; }
+static void id3_rede(void *v, int n) { usar_rede = 1; tiro_id3_introsort((int *)v, n); usar_rede = 0; }
+static void id5_rede(void *v, int n) { usar_rede = 1; tiro_id5_pdqsort((int *)v, n); usar_rede = 0; }
+
+const Motor motores_tiro[] = {
+    { "tiro.id1_quicksort",   FAMILIA_INT, 0, id1 },
+    { "tiro.id2_radix_afs",   FAMILIA_INT, 0, id2 },
+    { "tiro.id3_introsort",   FAMILIA_INT, 0, id3 },
+    { "tiro.id4_radix_lsd",   FAMILIA_INT, 0, id4 },
+    { "tiro.id5_pdqsort",     FAMILIA_INT, 0, id5 },
+    { "tiro.id1_quicksort_rede", FAMILIA_INT, 0, id1_rede },
+    { "tiro.id2_radix_afs_rede", FAMILIA_INT, 0, id2_rede },
+    { "tiro.id3_introsort_rede", FAMILIA_INT, 0, id3_rede },
+    { "tiro.id5_pdqsort_rede",   FAMILIA_INT, 0, id5_rede },
+    { NULL, 0, 0, NULL }
+};
@@ -0,0 +1,12 @@
+// Motor de setembro/aula_19_09/codigos/voltaUSPBubbleSortOtimizado.c (cocktail shaker sort)
+#define main voltausp_main
+#include "../setembro/aula_19_09/codigos/voltaUSPBubbleSortOtimizado.c"
+
+#include "motores.h"
+
+static void shaker(void *v, int n) { ordenacaoBubbleSort((int *)v, n); }
+
+const Motor motores_voltausp[] = {
+    { "voltausp.shaker", FAMILIA_INT, 1, shaker },
+    { NULL, 0, 0, NULL }
+};
@@ -0,0 +1,214 @@
+/*
+    ordenacao_generica.h
+    - "Templates" de ordenacao em C: introsort, merge sort (estavel), heapsort e insercao, especializados em
+      tempo de compilacao para um tipo e um comparador, sem ponteiro de funcao (o qsort chama o comparador
+      por callback a cada comparacao; aqui ele e uma expressao inlinada no laco).
+    - Uso: definir o tipo, o sufixo dos nomes e o comparador estrito, e incluir este arquivo (uma vez por tipo):
+
+          #define ORDENACAO_TIPO int
+          #define ORDENACAO_SUFIXO int
+          #define ORDENACAO_MENOR(a, b) (*(a) < *(b))   // a, b: const ORDENACAO_TIPO *
+          #include "ordenacao_generica.h"
+
+      gera introsort_int, mergesort_int, heapsort_int e insercao_int, todas (ORDENACAO_TIPO *v, int n).
+      As tres macros sao removidas no fim, prontas para a proxima instancia.
+    - mergesort_* aloca um buffer de n elementos e devolve 0 se faltar memoria (v fica intacto); as demais
+      ordenam no lugar e nao sao estaveis.
+*/
+
+#if !defined(ORDENACAO_TIPO) || !defined(ORDENACAO_SUFIXO) || !defined(ORDENACAO_MENOR)
+#error "defina ORDENACAO_TIPO, ORDENACAO_SUFIXO e ORDENACAO_MENOR antes de incluir ordenacao_generica.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef ORDENACAO_GENERICA_COMUM
+#define ORDENACAO_GENERICA_COMUM
+#define ORDENACAO_CORTE_INSERCAO 16 // intervalos menores terminam por insercao
+#define ORDENACAO_NINTHER 128       // acima disso, pivo pela mediana de tres medianas
+#define ORDENACAO_CONCAT_(a, b) a##_##b
+#define ORDENACAO_CONCAT(a, b) ORDENACAO_CONCAT_(a, b)
+#endif
+
+#define ORD_T ORDENACAO_TIPO
+#define ORD_F(nome) ORDENACAO_CONCAT(nome, ORDENACAO_SUFIXO)
+
+// Insercao em [lo, hi)
+static inline void ORD_F(insercao_intervalo)(ORD_T *v, int lo, int hi) {
+    for (int i = lo + 1; i < hi; i++) {
+        ORD_T x = v[i];
+        int j = i - 1;
+        while (j >= lo && ORDENACAO_MENOR(&x, &v[j])) {
+            v[j + 1] = v[j];
+            j--;
+        }
+        v[j + 1] = x;
+    }
+}
+
+static inline void ORD_F(insercao)(ORD_T *v, int n) {
+    ORD_F(insercao_intervalo)(v, 0, n);
+}
+
+// Desce v[base + i] no heap de maximo v[base..base + n)
+static inline void ORD_F(peneirar)(ORD_T *v, int base, int i, int n) {
+    ORD_T x = v[base + i];
+    for (;;) {
+        int filho = 2 * i + 1;
+        if (filho >= n)
+            break;
+        if (filho + 1 < n && ORDENACAO_MENOR(&v[base + filho], &v[base + filho + 1]))
+            filho++;
+        if (!ORDENACAO_MENOR(&x, &v[base + filho]))
+            break;
+        v[base + i] = v[base + filho];
+        i = filho;
+    }
+    v[base + i] = x;
+}
+
+// Heapsort em [lo, hi)
+static inline void ORD_F(heapsort_intervalo)(ORD_T *v, int lo, int hi) {
+    int n = hi - lo;
+    for (int i = n / 2 - 1; i >= 0; i--)
+        ORD_F(peneirar)(v, lo, i, n);
+    for (int fim = n - 1; fim > 0; fim--) {
+        ORD_T t = v[lo];
+        v[lo] = v[lo + fim];
+        v[lo + fim] = t;
+        ORD_F(peneirar)(v, lo, 0, fim);
+    }
+}
+
+static inline void ORD_F(heapsort)(ORD_T *v, int n) {
+    ORD_F(heapsort_intervalo)(v, 0, n);
+}
+
+static inline int ORD_F(mediana3)(const ORD_T *v, int i, int j, int k) {
+    if (ORDENACAO_MENOR(&v[i], &v[j])) {
+        if (ORDENACAO_MENOR(&v[j], &v[k])) return j;
+        return ORDENACAO_MENOR(&v[i], &v[k]) ? k : i;
+    }
+    if (ORDENACAO_MENOR(&v[i], &v[k])) return i;
+    return ORDENACAO_MENOR(&v[j], &v[k]) ? k : j;
+}
+
+// Hoare em [lo, hi] com o pivo (mediana) levado para v[lo]; devolve j com v[lo..j] <= pivo <= v[j+1..hi]
+static inline int ORD_F(particiona)(ORD_T *v, int lo, int hi) {
+    int n = hi - lo + 1, meio = lo + n / 2, m;
+    if (n > ORDENACAO_NINTHER) {
+        int d = n / 8;
+        m = ORD_F(mediana3)(v, ORD_F(mediana3)(v, lo, lo + d, lo + 2 * d),
+                               ORD_F(mediana3)(v, meio - d, meio, meio + d),
+                               ORD_F(mediana3)(v, hi - 2 * d, hi - d, hi));
+    }
+    else
+        m = ORD_F(mediana3)(v, lo, meio, hi);
+
+    ORD_T pivo = v[m];
+    v[m] = v[lo];
+    v[lo] = pivo;
+
+    int i = lo - 1, j = hi + 1;
+    for (;;) {
+        do i++; while (ORDENACAO_MENOR(&v[i], &pivo));
+        do j--; while (ORDENACAO_MENOR(&pivo, &v[j]));
+        if (i >= j)
+            return j;
+        ORD_T t = v[i];
+        v[i] = v[j];
+        v[j] = t;
+    }
+}
+
+// Recursao so no lado menor (pilha O(log n)); estourando a profundidade, heapsort no que sobrou
+static inline void ORD_F(introsort_rec)(ORD_T *v, int lo, int hi, int profundidade) {
+    while (hi - lo + 1 > ORDENACAO_CORTE_INSERCAO) {
+        if (profundidade-- == 0) {
+            ORD_F(heapsort_intervalo)(v, lo, hi + 1);
+            return;
+        }
+
+        int p = ORD_F(particiona)(v, lo, hi);
+        if (p - lo < hi - p) {
+            ORD_F(introsort_rec)(v, lo, p, profundidade);
+            lo = p + 1;
+        }
+        else {
+            ORD_F(introsort_rec)(v, p + 1, hi, profundidade);
+            hi = p;
+        }
+    }
+    ORD_F(insercao_intervalo)(v, lo, hi + 1);
+}
+
+static inline void ORD_F(introsort)(ORD_T *v, int n) {
+    if (n <= 1 || v == NULL)
+        return;
+
+    int profundidade = 0;
+    for (int k = n; k > 1; k >>= 1)
+        profundidade += 2;
+    ORD_F(introsort_rec)(v, 0, n - 1, profundidade);
+}
+
+/* Merge sort bottom-up estavel: corridas de ORDENACAO_CORTE_INSERCAO por insercao, depois passes que
+alternam v e o buffer; pares ja em ordem sao copiados e um passe sem nenhuma fronteira fora de ordem
+encerra a ordenacao. Empates saem da esquerda primeiro. */
+static inline int ORD_F(mergesort)(ORD_T *v, int n) {
+    if (n <= 1 || v == NULL)
+        return 1;
+
+    ORD_T *buffer = (ORD_T *)malloc((size_t)n * sizeof(ORD_T));
+    if (!buffer)
+        return 0;
+
+    for (int lo = 0; lo < n; lo += ORDENACAO_CORTE_INSERCAO)
+        ORD_F(insercao_intervalo)(v, lo, lo + ORDENACAO_CORTE_INSERCAO < n ? lo + ORDENACAO_CORTE_INSERCAO : n);
+
+    ORD_T *src = v, *dst = buffer;
+    for (int largura = ORDENACAO_CORTE_INSERCAO; largura < n; largura *= 2) {
+        int ordenado = 1; // todas as fronteiras entre corridas (nao so as dos pares deste passe)
+        for (int lo = largura; lo < n && ordenado; lo += largura)
+            ordenado = !ORDENACAO_MENOR(&src[lo], &src[lo - 1]);
+        if (ordenado)
+            break;
+
+        for (int lo = 0; lo < n; lo += 2 * largura) {
+            int meio = lo + largura < n ? lo + largura : n;
+            int fim = lo + 2 * largura < n ? lo + 2 * largura : n;
+
+            if (meio >= fim || !ORDENACAO_MENOR(&src[meio], &src[meio - 1])) {
+                memcpy(&dst[lo], &src[lo], (size_t)(fim - lo) * sizeof(ORD_T));
+                continue;
+            }
+
+            int i = lo, j = meio, k = lo;
+            while (i < meio && j < fim) {
+                if (ORDENACAO_MENOR(&src[j], &src[i]))
+                    dst[k++] = src[j++];
+                else
+                    dst[k++] = src[i++];
+            }
+            memcpy(&dst[k], &src[i], (size_t)(meio - i) * sizeof(ORD_T));
+            k += meio - i;
+            memcpy(&dst[k], &src[j], (size_t)(fim - j) * sizeof(ORD_T));
+        }
+
+        ORD_T *t = src;
+        src = dst;
+        dst = t;
+    }
+
+    if (src != v)
+        memcpy(v, src, (size_t)n * sizeof(ORD_T));
+    free(buffer);
+    return 1;
+}
+
+#undef ORD_F
+#undef ORD_T
+#undef ORDENACAO_TIPO
+#undef ORDENACAO_SUFIXO
+#undef ORDENACAO_MENOR
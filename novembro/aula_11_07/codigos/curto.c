@@ -115,6 +115,23 @@ typedef struct {
     int idx;
 } QueryPair;
 
+/* Com -DORDENACAO_GENERICA as ordenacoes usam instancias de benchmark/ordenacao_generica.h (introsort com o
+comparador inlinado) em vez do qsort com callback; o header vem do -I (gcc -DORDENACAO_GENERICA
+-I <raiz>/benchmark curto.c). Sem a flag, o arquivo continua autocontido para o runcodes */
+#ifdef ORDENACAO_GENERICA
+#define ORDENACAO_TIPO long
+#define ORDENACAO_SUFIXO long
+#define ORDENACAO_MENOR(a, b) (*(a) < *(b))
+#include "ordenacao_generica.h"
+
+#define ORDENACAO_TIPO QueryPair
+#define ORDENACAO_SUFIXO query
+#define ORDENACAO_MENOR(a, b) ((a)->key < (b)->key)
+#include "ordenacao_generica.h"
+
+#define ORDENAR_LONGS(v, n) introsort_long((v), (n))
+#define ORDENAR_CONSULTAS(v, n) introsort_query((v), (n))
+#else
 static int compare_query_pair(const void *a, const void *b) {
     const QueryPair *qa = (const QueryPair *)a;
     const QueryPair *qb = (const QueryPair *)b;
@@ -123,6 +140,10 @@ static int compare_query_pair(const void *a, const void *b) {
     return 0;
 }
 
+#define ORDENAR_LONGS(v, n) qsort((v), (n), sizeof(long), compare_longs)
+#define ORDENAR_CONSULTAS(v, n) qsort((v), (n), sizeof(QueryPair), compare_query_pair)
+#endif
+
 // Converte data "dd-mm-yyyy" para formato long "yyyymmdd"
 long convert_date_to_long(char *date_str) {
     int d, m, y;
@@ -150,7 +171,7 @@ static int next_prime(int x) {
 
 // Funcao que implementa o algoritmo 3 otimizado (offline: sort + merge)
 static void search_offline_sequential(long *date_vector, int N, long *search_vector, int Q) {
-    qsort(date_vector, N, sizeof(long), compare_longs);
+    ORDENAR_LONGS(date_vector, N);
 
     QueryPair *qs = (QueryPair *)malloc(sizeof(QueryPair) * (Q > 0 ? Q : 1));
     for (int i = 0; i < Q; i++) {
@@ -158,7 +179,7 @@ static void search_offline_sequential(long *date_vector, int N, long *search_vec
         qs[i].idx = i;
     }
     
-    qsort(qs, Q, sizeof(QueryPair), compare_query_pair);
+    ORDENAR_CONSULTAS(qs, Q);
 
     int *ans = (int *)calloc(Q > 0 ? Q : 1, sizeof(int));
 
@@ -219,7 +240,7 @@ int main() {
 
     switch (algorithm_choice) {
         case 1: // Busca binaria
-            qsort(date_vector, N, sizeof(long), compare_longs);
+            ORDENAR_LONGS(date_vector, N);
             for (int i = 0; i < Q; i++) {
                 found = binary_search(date_vector, N, search_vector[i]);
                 puts(found ? "ENCONTRADA" : "NAO_ENCONTRADA");
@@ -15,11 +15,22 @@ Cuidados:
 #include <stdio.h>
 #include <stdlib.h>
 
+// Com -DORDENACAO_GENERICA: introsort de benchmark/ordenacao_generica.h (comparacao inlinada) no lugar do qsort
+// (o header vem do -I: gcc -DORDENACAO_GENERICA -I <raiz>/benchmark somasBinario.c)
+#ifdef ORDENACAO_GENERICA
+#define ORDENACAO_TIPO int
+#define ORDENACAO_SUFIXO int
+#define ORDENACAO_MENOR(a, b) (*(a) < *(b))
+#include "ordenacao_generica.h"
+#define ORDENAR_INTS(v, n) introsort_int((v), (n))
+#else
 // Comparador para qsort: retorna negativo, zero ou positivo conforme ordenacao
 static int cmpInt(const void *a,const void *b){
     int A = *(const int*)a, B = *(const int*)b;
     return (A>B)-(A<B);         // forma sucinta: 1,0,-1
 }
+#define ORDENAR_INTS(v, n) qsort((v), (n), sizeof(int), cmpInt)
+#endif
 
 int main(){
     int N;
@@ -29,7 +40,7 @@ int main(){
     int *A = (int*)malloc(sizeof(int)*N);  // aloca vetor
     for (int i=0;i<N;i++) 
         scanf("%d",&A[i]); // lê elementos
-    qsort(A,N,sizeof(int),cmpInt); // ordena para permitir busca binaria
+    ORDENAR_INTS(A,N); // ordena para permitir busca binaria
 
     int M; scanf("%d",&M); // numero de consultas
     for (int q=0;q<M;q++){
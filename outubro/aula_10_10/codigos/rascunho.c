@@ -3,11 +3,12 @@
 #include <string.h>
 #include <stdint.h> // Necessário para o tipo uint32_t usado em util.h
 #include "util.h"
+#include "rede_ordenacao.h"
 
 /*
     Programa geral de ordenação:
     - Gera uma sequência (sorted/reverse/random) de inteiros 1..n
-    - Ordena com um entre três algoritmos (Quicksort/Mergesort/Heapsort)
+    - Ordena com um entre quatro algoritmos (Quicksort/Mergesort/Heapsort/Block merge sort)
     - Emite um hash CRC32 do conteúdo final como verificação rápida de corretude
 
     Observações de desempenho:
@@ -17,11 +18,17 @@
       O(n log n) no pior/médio/melhor, estável.
     - Heapsort (construção de Floyd + extrações sucessivas)
       O(n log n) no pior/médio/melhor; in-place, não estável.
+    - Block merge sort (ID 4, para memória restrita): mergesort bottom-up estável com buffer de O(sqrt n)
+      inteiros em vez de n; runs longas são mescladas em blocos de sqrt(n) (estilo WikiSort/GrailSort).
+      O(n log n), O(n) por nível. Sem memória nem para o buffer, cai na mescla por rotações (inplace_merge_sym).
+    - --rede: o cutoff do Quicksort usa as redes de ordenação de rede_ordenacao.h (AVX2 quando disponível)
+      no lugar do insertion sort; o CRC não muda.
 */
 
 void algoritmo_id1_quicksort(int *array, int n);
 void algoritmo_id2_mergesort(int *array, int n);
 void algoritmo_id3_heapsort(int *array, int n);
+void algoritmo_id4_blockmerge(int *array, int n);
 
 // Troca simples de dois inteiros por referencia
 static void swap_int(int *a, int *b) {
@@ -49,6 +56,16 @@ static void insertion_sort(int *a, int lo, int hi) {
     }
 }
 
+// Cutoff do Quicksort (no máximo REDE_MAXIMO elementos): insertion sort ou, com --rede, rede de ordenação
+static int usar_rede = 0;
+
+static void cutoff_sort(int *a, int lo, int hi) {
+    if (usar_rede)
+        rede_ordenar(a + lo, hi - lo + 1);
+    else
+        insertion_sort(a, lo, hi);
+}
+
 // Escolha de pivo por mediana de tres: a[lo], a[mid], a[hi]
 // Reduz a chance de piores casos em entradas quase ordenadas
 static int median_of_three(int *a, int lo, int hi) {
@@ -106,7 +123,7 @@ static void quicksort_impl(int *a, int lo, int hi) {
     // - Recursao sempre na menor metade (eliminacao de recursao de cauda), limitando profundidade para O(log n)
     while (lo < hi) {
         if (hi - lo + 1 <= 32) { // cutoff reduz chamadas recursivas e melhora cache
-            insertion_sort(a, lo, hi);
+            cutoff_sort(a, lo, hi);
             break;
         }
         
@@ -191,8 +208,9 @@ static void inplace_merge_sym(int *a, size_t first, size_t mid, size_t last) {
     // Já está ordenado na fronteira entre os blocos
     if (a[mid - 1] <= a[mid]) return;
 
-    if ((mid - first) <= (last - mid)) {
-        // Lado esquerdo menor: divide à esquerda, encontra posição na direita, rotaciona e recursa
+    // Divide sempre o lado maior: dividir o menor com 1 elemento à direita não reduz o problema (recursão infinita)
+    if ((mid - first) >= (last - mid)) {
+        // Lado esquerdo maior: divide à esquerda, encontra posição na direita, rotaciona e recursa
         size_t mid1 = first + ((mid - first) >> 1);
         int val = a[mid1];
         size_t mid2 = lower_bound_idx(a, mid, last, val);
@@ -201,7 +219,7 @@ static void inplace_merge_sym(int *a, size_t first, size_t mid, size_t last) {
         inplace_merge_sym(a, first, mid1, new_mid);
         inplace_merge_sym(a, new_mid, mid2, last);
     } else {
-        // Lado direito menor: divide à direita, encontra posição na esquerda, rotaciona e recursa
+        // Lado direito maior: divide à direita, encontra posição na esquerda, rotaciona e recursa
         size_t mid2 = mid + ((last - mid) >> 1);
         int val = a[mid2];
         size_t mid1 = upper_bound_idx(a, first, mid, val);
@@ -333,7 +351,187 @@ void algoritmo_id3_heapsort(int *restrict array, int n) {
     }
 }
 
-int main() {
+/************************** Block merge sort (buffer de sqrt(n)) *********************************/
+// Mergesort bottom-up estável que usa só um buffer de B inteiros (B = potência de 2 >= sqrt(n)) e um vetor
+// de ~2n/B índices de blocos, em vez das rotações de inplace_merge_sym (O(n log^2 n) e pouca localidade):
+// - Runs de BLOCO_RUN por insertion sort; larguras sempre potências de 2
+// - Metade esquerda com até B elementos: copiada para o buffer e mesclada para a frente (merge comum)
+// - Metades maiores: a esquerda (A) tem largura/B blocos cheios, a direita (B) seus blocos cheios e uma
+//   cauda menor que B. Os blocos cheios são reordenados pelo primeiro elemento (empate: A antes, estável),
+//   cada um movido uma vez por ciclo da permutação; depois uma varredura mescla cada bloco com o que
+//   sobrou do anterior de outra origem (sempre <= B elementos no buffer). A cauda entra por último,
+//   mesclada de trás para frente. Cada nível custa O(n) movimentos.
+#define BLOCO_RUN 32
+
+// [first, mid) com até B elementos vai para buf; mescla para a frente com [mid, last). Empate: esquerda primeiro
+static void merge_buffer_frente(int *a, int *buf, size_t first, size_t mid, size_t last) {
+    size_t tam = mid - first, i = 0, j = mid, k = first;
+    memcpy(buf, &a[first], tam * sizeof(int));
+
+    while (i < tam && j < last) {
+        if (buf[i] <= a[j])
+            a[k++] = buf[i++];
+        else
+            a[k++] = a[j++];
+    }
+
+    // O que sobrou de [mid, last) já está no lugar
+    memcpy(&a[k], &buf[i], (tam - i) * sizeof(int));
+}
+
+// [mid, last) com até B elementos vai para buf; mescla de trás para frente com [first, mid)
+static void merge_buffer_tras(int *a, int *buf, size_t first, size_t mid, size_t last) {
+    size_t tam = last - mid, i = tam, j = mid, k = last;
+    memcpy(buf, &a[mid], tam * sizeof(int));
+
+    while (i > 0 && j > first) {
+        if (a[j - 1] > buf[i - 1])
+            a[--k] = a[--j];
+        else
+            a[--k] = buf[--i];
+    }
+
+    memcpy(&a[first], buf, i * sizeof(int));
+}
+
+// Mescla A = [first, mid) (múltiplo de 'bloco') com os blocos cheios de B = [mid, last); 'ordem' e 'origem'
+// têm espaço para (last - first) / bloco entradas
+static void merge_em_blocos(int *a, int *buf, int *ordem, char *origem, size_t first, size_t mid, size_t last,
+                            size_t bloco) {
+    int na = (int)((mid - first) / bloco), nb = (int)((last - mid) / bloco), m = na + nb;
+
+    // Ordem dos blocos pelo primeiro elemento: merge das chaves de A e de B (empate: bloco de A antes)
+    int i = 0, j = 0;
+    for (int t = 0; t < m; t++) {
+        if (j >= nb || (i < na && a[first + (size_t)i * bloco] <= a[mid + (size_t)j * bloco])) {
+            ordem[t] = i++;
+            origem[t] = 0;
+        }
+        else {
+            ordem[t] = na + j++;
+            origem[t] = 1;
+        }
+    }
+
+    // Aplica a permutação (posição t recebe o bloco ordem[t]) seguindo os ciclos, com buf de área temporária
+    for (int t = 0; t < m; t++) {
+        if (ordem[t] == t)
+            continue;
+
+        memcpy(buf, &a[first + (size_t)t * bloco], bloco * sizeof(int));
+        int atual = t;
+        while (ordem[atual] != t) {
+            int prox = ordem[atual];
+            memcpy(&a[first + (size_t)atual * bloco], &a[first + (size_t)prox * bloco], bloco * sizeof(int));
+            ordem[atual] = atual; // posição resolvida
+            atual = prox;
+        }
+        memcpy(&a[first + (size_t)atual * bloco], buf, bloco * sizeof(int));
+        ordem[atual] = atual;
+    }
+
+    // Varredura: [ini, fim) é o que sobrou do último merge (origem 'orig'), sempre colado ao próximo bloco.
+    // Tudo que sai antes dele já está na posição final: blocos seguintes começam em chaves >= às já emitidas.
+    size_t ini = first, fim = first + bloco;
+    int orig = origem[0];
+    for (int t = 1; t < m; t++) {
+        size_t bl = fim, bf = fim + bloco;
+        if (origem[t] == orig) {
+            ini = bl;
+            fim = bf;
+            continue;
+        }
+
+        size_t tam = fim - ini, p = 0, q = bl, k = ini;
+        memcpy(buf, &a[ini], tam * sizeof(int));
+        while (p < tam && q < bf) {
+            // Empate: elemento de A (origem 0) primeiro
+            if (orig == 0 ? buf[p] <= a[q] : buf[p] < a[q])
+                a[k++] = buf[p++];
+            else
+                a[k++] = a[q++];
+        }
+
+        if (p == tam) {
+            // Sobra o fim do bloco novo, já no lugar
+            ini = q;
+            orig = origem[t];
+        }
+        else {
+            // Sobra o fim do anterior: vai para o fim do bloco novo
+            memcpy(&a[k], &buf[p], (tam - p) * sizeof(int));
+            ini = k;
+        }
+        fim = bf;
+    }
+}
+
+// Fallback sem buffer: mesma estrutura bottom-up, mesclando por rotações em O(1) de espaço
+static void mergesort_rotacoes(int *a, size_t n) {
+    for (size_t width = 1; width < n; width <<= 1) {
+        for (size_t i = 0; i + width < n; i += (width << 1)) {
+            size_t right = (i + (width << 1) < n) ? i + (width << 1) : n;
+            inplace_merge_sym(a, i, i + width, right);
+        }
+    }
+}
+
+void algoritmo_id4_blockmerge(int *array, int n) {
+    if (n <= 1) return;
+
+    size_t N = (size_t)n, bloco = 1;
+    while (bloco * bloco < N)
+        bloco <<= 1;
+
+    // buf: um bloco; ordem/origem: um merge cobre no máximo N elementos, N / bloco blocos cheios
+    size_t max_blocos = N / bloco + 1;
+    int *buf = (int *)malloc(bloco * sizeof(int));
+    int *ordem = (int *)malloc(max_blocos * sizeof(int));
+    char *origem = (char *)malloc(max_blocos);
+    if (buf == NULL || ordem == NULL || origem == NULL) {
+        free(buf);
+        free(ordem);
+        free(origem);
+        mergesort_rotacoes(array, N);
+        return;
+    }
+
+    for (size_t i = 0; i < N; i += BLOCO_RUN)
+        insertion_sort(array, (int)i, (int)((i + BLOCO_RUN < N ? i + BLOCO_RUN : N) - 1));
+
+    for (size_t width = BLOCO_RUN; width < N; width <<= 1) {
+        for (size_t i = 0; i + width < N; i += (width << 1)) {
+            size_t first = i, mid = i + width;
+            size_t last = (i + (width << 1) < N) ? i + (width << 1) : N;
+
+            // Fronteira já em ordem: nada a fazer
+            if (array[mid - 1] <= array[mid])
+                continue;
+
+            if (width <= bloco) {
+                merge_buffer_frente(array, buf, first, mid, last);
+                continue;
+            }
+
+            // Blocos cheios de B entram no merge em blocos; a cauda (< bloco) entra depois, por trás
+            size_t cauda = (last - mid) % bloco, fim_blocos = last - cauda;
+            if (fim_blocos > mid)
+                merge_em_blocos(array, buf, ordem, origem, first, mid, fim_blocos, bloco);
+            if (cauda > 0)
+                merge_buffer_tras(array, buf, first, fim_blocos, last);
+        }
+    }
+
+    free(buf);
+    free(ordem);
+    free(origem);
+}
+
+int main(int argc, char *argv[]) {
+    for (int i = 1; i < argc; i++)
+        if (strcmp(argv[i], "--rede") == 0)
+            usar_rede = 1;
+
     int n, id_algoritmo;
     char tipo_sequencia[10];
 
@@ -397,6 +595,10 @@ int main() {
             algoritmo_id3_heapsort(sequencia, n);
             break;
 
+        case 4:
+            algoritmo_id4_blockmerge(sequencia, n);
+            break;
+
         default:
             printf("Algoritmo com ID %d nao implementado.\n", id_algoritmo);
             free(sequencia);
@@ -0,0 +1,204 @@
+#ifndef REDE_ORDENACAO_H
+#define REDE_ORDENACAO_H
+
+#include <limits.h>
+#include <string.h>
+
+/*
+    rede_ordenacao.h
+    - Redes de ordenacao bitonicas para blocos de ate 32 ints, alternativa ao insertion sort no cutoff dos
+      algoritmos hibridos (quicksort/introsort 16, pdqsort 24, runs do mergesort e radix MSD 32, cauda do heapsort).
+    - Sequencia fixa de comparar-trocar (min/max), sem desvio dependente do dado: o custo nao depende da entrada,
+      ao contrario do insertion sort, cujo laco interno erra a previsao em quase toda chave de entrada aleatoria.
+    - AVX2 (detectado em tempo de execucao): 8 ints por registrador; ordena 8 dentro do registrador, 16 e 32 com
+      merge bitonico entre registradores. Sem AVX2, a mesma rede em escalar (min/max viram cmov).
+    - rede_ordenar(a, n), n <= REDE_MAXIMO: completa o bloco ate 8/16/32 com INT_MAX, que vao para o fim e sao
+      descartados (no AVX2, por carga/escrita mascaradas). So ints: a falta de estabilidade nao muda o CRC.
+*/
+
+#define REDE_MAXIMO 32
+
+// Tamanho da rede que cobre n elementos (n <= REDE_MAXIMO)
+static inline int rede_tamanho(int n) {
+    return n <= 8 ? 8 : (n <= 16 ? 16 : 32);
+}
+
+// Rede bitonica escalar em v[0..m), m potencia de 2: referencia e fallback sem AVX2
+static inline void rede_ordenar_escalar_bloco(int *v, int m) {
+    for (int k = 2; k <= m; k <<= 1) {
+        for (int j = k >> 1; j > 0; j >>= 1) {
+            for (int i = 0; i < m; i++) {
+                int l = i ^ j;
+                if (l < i)
+                    continue;
+
+                // Sentido da troca depende so de (i, k): nada dependente do dado alem de min/max
+                int x = v[i], y = v[l];
+                int menor = x < y ? x : y, maior = x < y ? y : x;
+                v[i] = (i & k) ? maior : menor;
+                v[l] = (i & k) ? menor : maior;
+            }
+        }
+    }
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+
+// Um estagio de comparar-trocar com o parceiro da faixa i em i ^ j (j = 1, 2, 4); 'maximos' marca as faixas
+// que ficam com o maior do par. O parceiro vem de um shuffle, entao o estagio inteiro e min + max + blend.
+#define REDE_ESTAGIO(x, parceiro, maximos) \
+    _mm256_blend_epi32(_mm256_min_epi32(x, parceiro), _mm256_max_epi32(x, parceiro), maximos)
+#define REDE_PAR_1(x) _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1))
+#define REDE_PAR_2(x) _mm256_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2))
+#define REDE_PAR_4(x) _mm256_permute2x128_si256(x, x, 0x01)
+
+// Termina a ordenacao de um registrador bitonico (crescente)
+__attribute__((target("avx2")))
+static inline __m256i rede_merge8_avx2(__m256i x) {
+    x = REDE_ESTAGIO(x, REDE_PAR_4(x), 0xF0);
+    x = REDE_ESTAGIO(x, REDE_PAR_2(x), 0xCC);
+    return REDE_ESTAGIO(x, REDE_PAR_1(x), 0xAA);
+}
+
+// Ordena as 8 faixas de um registrador: 6 estagios da rede bitonica
+__attribute__((target("avx2")))
+static inline __m256i rede_ordenar8_avx2(__m256i x) {
+    x = REDE_ESTAGIO(x, REDE_PAR_1(x), 0x66);
+    x = REDE_ESTAGIO(x, REDE_PAR_2(x), 0x3C);
+    x = REDE_ESTAGIO(x, REDE_PAR_1(x), 0x5A);
+    return rede_merge8_avx2(x);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i rede_inverter_avx2(__m256i x) {
+    return _mm256_permutevar8x32_epi32(x, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+// Mescla dois registradores crescentes em *a (8 menores) e *b (8 maiores): inverter b torna a||b bitonica
+__attribute__((target("avx2")))
+static inline void rede_merge16_avx2(__m256i *a, __m256i *b) {
+    __m256i r = rede_inverter_avx2(*b);
+    __m256i menor = _mm256_min_epi32(*a, r), maior = _mm256_max_epi32(*a, r);
+    *a = rede_merge8_avx2(menor);
+    *b = rede_merge8_avx2(maior);
+}
+
+// Termina a ordenacao de 16 valores bitonicos em (a, b)
+__attribute__((target("avx2")))
+static inline void rede_merge16_bitonico_avx2(__m256i *a, __m256i *b) {
+    __m256i menor = _mm256_min_epi32(*a, *b), maior = _mm256_max_epi32(*a, *b);
+    *a = rede_merge8_avx2(menor);
+    *b = rede_merge8_avx2(maior);
+}
+
+// Ordena os m / 8 registradores de x (m = 8, 16 ou 32) como uma sequencia so
+__attribute__((target("avx2")))
+static inline void rede_ordenar_registradores_avx2(__m256i *x, int m) {
+    x[0] = rede_ordenar8_avx2(x[0]);
+    if (m == 8)
+        return;
+
+    x[1] = rede_ordenar8_avx2(x[1]);
+    rede_merge16_avx2(&x[0], &x[1]);
+    if (m == 16)
+        return;
+
+    x[2] = rede_ordenar8_avx2(x[2]);
+    x[3] = rede_ordenar8_avx2(x[3]);
+    rede_merge16_avx2(&x[2], &x[3]);
+
+    // x0||x1 crescente contra x2||x3 invertido (= inv(x3)||inv(x2)): metades de 16 bitonicas
+    __m256i r3 = rede_inverter_avx2(x[3]), r2 = rede_inverter_avx2(x[2]);
+    __m256i m0 = _mm256_min_epi32(x[0], r3), m1 = _mm256_min_epi32(x[1], r2);
+    __m256i x0 = _mm256_max_epi32(x[0], r3), x1 = _mm256_max_epi32(x[1], r2);
+    rede_merge16_bitonico_avx2(&m0, &m1);
+    rede_merge16_bitonico_avx2(&x0, &x1);
+    x[0] = m0;
+    x[1] = m1;
+    x[2] = x0;
+    x[3] = x1;
+}
+
+// a[0..n), 2 <= n <= 32: carga e escrita mascaradas, faixas alem de n entram como INT_MAX e nao sao gravadas
+__attribute__((target("avx2")))
+static void rede_ordenar_avx2(int *a, int n) {
+    const __m256i faixa = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i infinito = _mm256_set1_epi32(INT_MAX);
+    __m256i x[REDE_MAXIMO / 8], mascara[REDE_MAXIMO / 8];
+    int m = rede_tamanho(n);
+
+    for (int r = 0; r < m / 8; r++) {
+        if (n >= 8 * (r + 1)) {
+            mascara[r] = _mm256_set1_epi32(-1);
+            x[r] = _mm256_loadu_si256((const __m256i *)(a + 8 * r));
+        }
+        else {
+            mascara[r] = _mm256_cmpgt_epi32(_mm256_set1_epi32(n - 8 * r), faixa);
+            x[r] = _mm256_blendv_epi8(infinito, _mm256_maskload_epi32(a + 8 * r, mascara[r]), mascara[r]);
+        }
+    }
+
+    rede_ordenar_registradores_avx2(x, m);
+
+    for (int r = 0; r < m / 8; r++) {
+        if (n >= 8 * (r + 1))
+            _mm256_storeu_si256((__m256i *)(a + 8 * r), x[r]);
+        else
+            _mm256_maskstore_epi32(a + 8 * r, mascara[r], x[r]);
+    }
+}
+
+#undef REDE_ESTAGIO
+#undef REDE_PAR_1
+#undef REDE_PAR_2
+#undef REDE_PAR_4
+
+static inline int rede_usa_avx2(void) {
+    static int usa = -1;
+    if (usa < 0) {
+        __builtin_cpu_init();
+        usa = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return usa;
+}
+#endif
+
+// Ordena a[0..n) com a rede escolhida; na versao escalar, blocos incompletos passam por um buffer
+// completado com INT_MAX
+static inline void rede_ordenar_com(int *a, int n, int usa_avx2) {
+    if (n <= 1)
+        return;
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    if (usa_avx2) {
+        rede_ordenar_avx2(a, n);
+        return;
+    }
+#else
+    (void)usa_avx2;
+#endif
+
+    int m = rede_tamanho(n), buffer[REDE_MAXIMO];
+    if (n == m) {
+        rede_ordenar_escalar_bloco(a, m);
+        return;
+    }
+
+    memcpy(buffer, a, (size_t)n * sizeof(int));
+    for (int i = n; i < m; i++)
+        buffer[i] = INT_MAX;
+    rede_ordenar_escalar_bloco(buffer, m);
+    memcpy(a, buffer, (size_t)n * sizeof(int));
+}
+
+// Ordena a[0..n), n <= REDE_MAXIMO, com AVX2 quando a CPU suporta
+static inline void rede_ordenar(int *a, int n) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    rede_ordenar_com(a, n, rede_usa_avx2());
+#else
+    rede_ordenar_com(a, n, 0);
+#endif
+}
+
+#endif
@@ -1,12 +1,26 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
 #include <stdint.h> // Necessario para o tipo uint32_t usado em util.h
+#include <limits.h> // INT_MAX (validacao do nmax do --bench)
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
 #include "util.h"
+#include "rede_ordenacao.h"
+
+// Instrumentacao opcional (Linux): -DCONTADORES_HW imprime em stderr os contadores de hardware da ordenacao
+#ifdef CONTADORES_HW
+#include "../../../benchmark/contadores.h"
+#endif
 
 /*
     Programa geral de ordenacao:
-    - Gera uma sequencia (sorted/reverse/random) de inteiros 1..n
+    - Gera uma sequencia (sorted/reverse/random/streams) de inteiros 1..n
+      ("streams": fluxos xorshift independentes em SIMD, gerados em paralelo com --threads; CRC proprio)
     - Ordena com um algoritmo (Quicksort/Radix sort/Counting sort)
     - Emite um CRC32 do conteudo final para verificacao rapida
 
@@ -14,11 +28,26 @@
     - Quicksort: Hoare + mediana de tres + cutoff p/ insertion. O(n log n) medio; O(n^2) pior (mitigado pelo pivo).
     - Radix sort (MSD, American flag): base 256, in-place, nao estavel. O(w*n), w = bytes.
     - Counting sort: O(n + k). Eficiente em intervalo compacto; fallback p/ quicksort se k grande.
+    - Radix sort LSD (algoritmo 4): base 256, fora do lugar, estavel. Um unico passe conta os 4 histogramas
+      e passes cujo byte e constante em todo o vetor sao pulados (valores em [1..n] raramente usam o byte alto).
+    - pdqsort (algoritmo 5): particionamento em blocos sem desvios (BlockQuicksort), deteccao de entradas
+      ja particionadas/ordenadas e fallback para heapsort; O(n) em sorted/reverse, O(n log n) no pior caso.
+    - Introsort paralelo (--threads N [--cutoff C]): as duas metades de cada partition_hoare viram
+      tarefas num pool com roubo de trabalho; abaixo do cutoff cada tarefa roda o introsort sequencial.
+    - --rede: o cutoff de insertion sort dos hibridos (quicksort, radix MSD, introsort, pdqsort) passa a usar as
+      redes de ordenacao de rede_ordenacao.h (8/16/32 ints, AVX2 quando disponivel); o CRC nao muda.
+
+    Compilacao: gcc -O2 -pthread tiroNoEscuro.c -o tiroNoEscuro
+    Uso: ./tiroNoEscuro [--threads N] [--cutoff C] [--rede] < entrada   (N = 0 usa todos os nucleos)
+         ./tiroNoEscuro --bench <ids> [tipos] [nmax]   (ex.: --bench 2,4 random 100000000; CSV na saida)
 */
 
 void algoritmo_id1_quicksort(int *array, int n);
 void algoritmo_id2_radixsort(int *array, int n);
 void algoritmo_id3_introsort(int *array, int n);
+void algoritmo_id3_introsort_paralelo(int *array, int n, int nthreads, int cutoff);
+void algoritmo_id4_radixsort_lsd(int *array, int n);
+void algoritmo_id5_pdqsort(int *array, int n);
 
 // Troca dois inteiros por referencia
 static void swap_int(int *a, int *b) {
@@ -44,6 +73,16 @@ static void insertion_sort(int *a, int lo, int hi) {
     }
 }
 
+// Cutoff dos hibridos (no maximo REDE_MAXIMO elementos): insertion sort ou, com --rede, rede de ordenacao
+static int usar_rede = 0;
+
+static void cutoff_sort(int *a, int lo, int hi) {
+    if (usar_rede)
+        rede_ordenar(a + lo, hi - lo + 1);
+    else
+        insertion_sort(a, lo, hi);
+}
+
 // Mediana de tres: escolhe pivo entre a[lo], a[mid], a[hi] e move para a[lo]
 static int median_of_three(int *a, int lo, int hi) {
     // Seleciona a mediana entre a[lo], a[mid], a[hi] e a move para a[lo] como pivo.
@@ -100,7 +139,7 @@ static void quicksort_impl(int *a, int lo, int hi) {
     // - Recursao sempre na menor metade (eliminacao de recursao de cauda), limitando profundidade para O(log n)
     while (lo < hi) {
         if (hi - lo + 1 <= 16) { // cutoff para pequenos subarrays (valor empirico)
-            insertion_sort(a, lo, hi);
+            cutoff_sort(a, lo, hi);
             break;
         }
         
@@ -141,7 +180,7 @@ static void radix_msd_afs(int *a, int lo, int hi, int shift) { // [lo, hi)
         return;
 
     if (len <= THRESH) { 
-        insertion_sort(a, lo, hi - 1); 
+        cutoff_sort(a, lo, hi - 1); 
         return; 
     }
 
@@ -195,6 +234,74 @@ void algoritmo_id2_radixsort(int *array, int n) {
     radix_msd_afs(array, 0, n, 24);
 }
 
+// Radix sort LSD (base 256) fora do lugar, com um unico passe de contagem para os 4 bytes
+// - Histogramas dos 4 bytes calculados juntos (uma leitura do vetor em vez de quatro)
+// - Passe pulado quando todos os elementos tem o mesmo byte naquela posicao
+// - Ping-pong entre array e tmp; copia de volta so se o resultado terminar em tmp
+void algoritmo_id4_radixsort_lsd(int *array, int n) {
+    if (n <= 1)
+        return;
+
+    size_t N = (size_t)n;
+    uint32_t count[4][256] = {{0}};
+
+    // Contagem: 4 bytes por elemento, desenrolado de 4 em 4 para expor paralelismo de instrucao
+    const uint32_t *u = (const uint32_t *)array;
+    size_t i = 0;
+
+    for (; i + 4 <= N; i += 4) {
+        uint32_t x0 = u[i] ^ 0x80000000u, x1 = u[i + 1] ^ 0x80000000u;
+        uint32_t x2 = u[i + 2] ^ 0x80000000u, x3 = u[i + 3] ^ 0x80000000u;
+
+        ++count[0][x0 & 0xFFu]; ++count[1][(x0 >> 8) & 0xFFu]; ++count[2][(x0 >> 16) & 0xFFu]; ++count[3][x0 >> 24];
+        ++count[0][x1 & 0xFFu]; ++count[1][(x1 >> 8) & 0xFFu]; ++count[2][(x1 >> 16) & 0xFFu]; ++count[3][x1 >> 24];
+        ++count[0][x2 & 0xFFu]; ++count[1][(x2 >> 8) & 0xFFu]; ++count[2][(x2 >> 16) & 0xFFu]; ++count[3][x2 >> 24];
+        ++count[0][x3 & 0xFFu]; ++count[1][(x3 >> 8) & 0xFFu]; ++count[2][(x3 >> 16) & 0xFFu]; ++count[3][x3 >> 24];
+    }
+
+    for (; i < N; ++i) {
+        uint32_t x = u[i] ^ 0x80000000u;
+        ++count[0][x & 0xFFu]; ++count[1][(x >> 8) & 0xFFu]; ++count[2][(x >> 16) & 0xFFu]; ++count[3][x >> 24];
+    }
+
+    int *tmp = NULL, *src = array, *dst = NULL;
+
+    for (int b = 0; b < 4; ++b) {
+        int shift = b << 3;
+
+        // Byte constante: todos caem no mesmo bucket, a permutacao seria a identidade
+        if (count[b][byte_of(array[0], shift)] == (uint32_t)N)
+            continue;
+
+        if (tmp == NULL) {
+            tmp = (int *)malloc(N * sizeof(int));
+            if (tmp == NULL) {
+                fprintf(stderr, "Erro ao alocar memoria auxiliar para radix sort.\n");
+                exit(1);
+            }
+            dst = tmp;
+        }
+
+        // Prefixos exclusivos: posicao inicial de cada bucket
+        size_t pos[256], sum = 0;
+        for (int k = 0; k < 256; ++k) {
+            pos[k] = sum;
+            sum += count[b][k];
+        }
+
+        // Distribuicao estavel src -> dst
+        for (size_t j = 0; j < N; ++j)
+            dst[pos[byte_of(src[j], shift)]++] = src[j];
+
+        int *swap = src; src = dst; dst = swap;
+    }
+
+    if (src != array)
+        memcpy(array, src, N * sizeof(int));
+
+    free(tmp);
+}
+
 // log2 inteiro de n (n > 0); usado para profundidade maxima do quicksort
 static int ilog2(int n) {
     int lg = 0;
@@ -265,7 +372,7 @@ static void introsort_impl(int *a, int lo, int hi, int depth_limit) {
         int len = hi - lo + 1;
 
         if (len <= 16) { // cutoff para insertion sort
-            insertion_sort(a, lo, hi);
+            cutoff_sort(a, lo, hi);
             return;
         }
 
@@ -299,28 +406,568 @@ void algoritmo_id3_introsort(int *array, int n) {
     introsort_impl(array, 0, n - 1, depth);
 }
 
-int main() {
-    int n, id_algoritmo;
-    char tipo_sequencia[10];
+/************************** Pattern-defeating quicksort (particionamento em blocos) *********************************/
+// Baseado no pdqsort (Orson Peters) e no BlockQuicksort (Edelkamp e Weiss):
+// - Particionamento sem desvios: os indices de elementos do lado errado sao gravados em buffers de
+//   deslocamento (offsets) de PDQ_BLOCK posicoes e trocados depois, sem branch dependente do dado
+// - Deteccao de particao ja feita: se nenhuma troca foi necessaria, tenta terminar com insertion sort parcial
+// - Pivos iguais ao anterior agrupam os repetidos a esquerda (partition_left) e pulam essa parte
+// - Particoes muito desbalanceadas embaralham alguns elementos; apos log2(n) delas, cai para heapsort
+#define PDQ_INSERTION_LIMIT 24
+#define PDQ_NINTHER_LIMIT 128
+#define PDQ_PARTIAL_INSERTION_LIMIT 8
+#define PDQ_BLOCK 64
+
+static void pdq_sort2(int *a, int *b) {
+    if (*b < *a)
+        swap_int(a, b);
+}
 
-    // Leitura: usa %9s para evitar overflow do buffer de 'tipo_sequencia'
-    scanf("%d", &n);
-    scanf("%9s", tipo_sequencia);
-    scanf("%d", &id_algoritmo);
+static void pdq_sort3(int *a, int *b, int *c) {
+    pdq_sort2(a, b);
+    pdq_sort2(b, c);
+    pdq_sort2(a, b);
+}
 
-    // Evita overflow de size_t e acesso invalido no CRC quando n < 0
-    if (n < 0) {
-        fprintf(stderr, "Valor de n invalido.\n");
-        return 1;
+// Insertion sort sem guarda em [begin, end): exige que *(begin - 1) seja <= todos os elementos
+static void pdq_insertion_unguarded(int *begin, int *end) {
+    for (int *cur = begin + 1; cur < end; ++cur) {
+        int *sift = cur, *sift_1 = cur - 1;
+
+        if (*sift < *sift_1) {
+            int tmp = *sift;
+
+            do {
+                *sift-- = *sift_1;
+            } while (tmp < *--sift_1);
+
+            *sift = tmp;
+        }
     }
+}
 
-    int *sequencia = (int *)malloc((size_t)n * sizeof(int));
-    if (sequencia == NULL && n > 0) {
+// Insertion sort que desiste apos PDQ_PARTIAL_INSERTION_LIMIT deslocamentos; retorna 1 se ordenou tudo
+static int pdq_partial_insertion(int *begin, int *end) {
+    size_t limit = 0;
+
+    for (int *cur = begin + 1; cur < end; ++cur) {
+        int *sift = cur, *sift_1 = cur - 1;
+
+        if (*sift < *sift_1) {
+            int tmp = *sift;
+
+            do {
+                *sift-- = *sift_1;
+            } while (sift != begin && tmp < *--sift_1);
+
+            *sift = tmp;
+            limit += (size_t)(cur - sift);
+        }
+
+        if (limit > PDQ_PARTIAL_INSERTION_LIMIT)
+            return 0;
+    }
+
+    return 1;
+}
+
+// Troca os pares (first + offsets_l[i], last - offsets_r[i]); sem 'use_swaps' faz um ciclo com uma so copia temporaria
+static void pdq_swap_offsets(int *first, int *last, const unsigned char *offsets_l,
+                             const unsigned char *offsets_r, size_t num, int use_swaps) {
+    if (use_swaps) {
+        // Necessario na distribuicao decrescente para o pdqsort continuar O(n)
+        for (size_t i = 0; i < num; ++i)
+            swap_int(first + offsets_l[i], last - offsets_r[i]);
+    }
+
+    else if (num > 0) {
+        int *l = first + offsets_l[0], *r = last - offsets_r[0];
+        int tmp = *l;
+        *l = *r;
+
+        for (size_t i = 1; i < num; ++i) {
+            l = first + offsets_l[i];
+            *r = *l;
+            r = last - offsets_r[i];
+            *l = *r;
+        }
+
+        *r = tmp;
+    }
+}
+
+// Particiona [begin, end) em torno de *begin: [< pivo] pivo [>= pivo]
+// Retorna a posicao final do pivo; *ja_particionado indica que nenhuma troca foi feita
+static int *pdq_partition_right_branchless(int *begin, int *end, int *ja_particionado) {
+    int pivot = *begin, *first = begin, *last = end;
+
+    // Primeiro elemento >= pivo (existe pela mediana de tres)
+    while (*++first < pivot);
+
+    // Primeiro elemento < pivo vindo da direita; precisa de guarda se nao ha nada antes de *first
+    if (first - 1 == begin)
+        while (first < last && !(*--last < pivot));
+    else
+        while (!(*--last < pivot));
+
+    *ja_particionado = first >= last;
+
+    if (!*ja_particionado) {
+        swap_int(first, last);
+        ++first;
+
+        unsigned char offsets_l[PDQ_BLOCK], offsets_r[PDQ_BLOCK];
+        int *offsets_l_base = first, *offsets_r_base = last;
+        size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+        while (first < last) {
+            // Quantos elementos cada bloco de offsets ainda vai examinar
+            size_t num_unknown = (size_t)(last - first);
+            size_t left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+            size_t right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+
+            // Preenche os offsets: o indice e sempre escrito, o contador so avanca se o elemento estiver errado
+            if (left_split > PDQ_BLOCK)
+                left_split = PDQ_BLOCK;
+
+            for (size_t i = 0; i < left_split; ++i) {
+                offsets_l[num_l] = (unsigned char)i;
+                num_l += !(*first < pivot);
+                ++first;
+            }
+
+            if (right_split > PDQ_BLOCK)
+                right_split = PDQ_BLOCK;
+
+            for (size_t i = 0; i < right_split; ) {
+                offsets_r[num_r] = (unsigned char)++i;
+                num_r += *--last < pivot;
+            }
+
+            // Troca o que for possivel e atualiza os blocos
+            size_t num = num_l < num_r ? num_l : num_r;
+            pdq_swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l, offsets_r + start_r,
+                             num, num_l == num_r);
+            num_l -= num;
+            num_r -= num;
+            start_l += num;
+            start_r += num;
+
+            if (num_l == 0) {
+                start_l = 0;
+                offsets_l_base = first;
+            }
+
+            if (num_r == 0) {
+                start_r = 0;
+                offsets_r_base = last;
+            }
+        }
+
+        // Sobrou um bloco com elementos do lado errado: leva-os para a fronteira
+        if (num_l) {
+            while (num_l--)
+                swap_int(offsets_l_base + offsets_l[start_l + num_l], --last);
+            first = last;
+        }
+
+        if (num_r) {
+            while (num_r--) {
+                swap_int(offsets_r_base - offsets_r[start_r + num_r], first);
+                ++first;
+            }
+            last = first;
+        }
+    }
+
+    // Coloca o pivo na posicao final
+    int *pivot_pos = first - 1;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pivot_pos;
+}
+
+// Particiona [begin, end) em [<= pivo] pivo [> pivo]; usado quando o pivo repete o elemento anterior
+static int *pdq_partition_left(int *begin, int *end) {
+    int pivot = *begin, *first = begin, *last = end;
+
+    while (pivot < *--last);
+
+    if (last + 1 == end)
+        while (first < last && !(pivot < *++first));
+    else
+        while (!(pivot < *++first));
+
+    while (first < last) {
+        swap_int(first, last);
+        while (pivot < *--last);
+        while (!(pivot < *++first));
+    }
+
+    *begin = *last;
+    *last = pivot;
+    return last;
+}
+
+static void pdq_loop(int *begin, int *end, int bad_allowed, int leftmost) {
+    // Laco para eliminar a recursao de cauda na particao direita
+    for (;;) {
+        ptrdiff_t size = end - begin;
+
+        if (size < PDQ_INSERTION_LIMIT) {
+            if (leftmost || usar_rede) // a rede nao depende da sentinela a esquerda
+                cutoff_sort(begin, 0, (int)size - 1);
+            else
+                pdq_insertion_unguarded(begin, end);
+            return;
+        }
+
+        // Pivo: mediana de tres ou pseudomediana de nove (ninther)
+        ptrdiff_t s2 = size / 2;
+        if (size > PDQ_NINTHER_LIMIT) {
+            pdq_sort3(begin, begin + s2, end - 1);
+            pdq_sort3(begin + 1, begin + (s2 - 1), end - 2);
+            pdq_sort3(begin + 2, begin + (s2 + 1), end - 3);
+            pdq_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1));
+            swap_int(begin, begin + s2);
+        }
+
+        else
+            pdq_sort3(begin + s2, begin, end - 1);
+
+        // *(begin - 1) e o pivo de uma particao anterior e nenhum elemento aqui e menor que ele.
+        // Se o novo pivo e igual, todos os iguais vao para a esquerda e ja estao no lugar.
+        if (!leftmost && !(*(begin - 1) < *begin)) {
+            begin = pdq_partition_left(begin, end) + 1;
+            continue;
+        }
+
+        int ja_particionado;
+        int *pivot_pos = pdq_partition_right_branchless(begin, end, &ja_particionado);
+
+        ptrdiff_t l_size = pivot_pos - begin, r_size = end - (pivot_pos + 1);
+        int desbalanceado = l_size < size / 8 || r_size < size / 8;
+
+        if (desbalanceado) {
+            // Muitas particoes ruins: heapsort garante O(n log n)
+            if (--bad_allowed == 0) {
+                heap_sort_range(begin, 0, (int)size - 1);
+                return;
+            }
+
+            // Embaralha alguns elementos para quebrar padroes que enganam a escolha do pivo
+            if (l_size >= PDQ_INSERTION_LIMIT) {
+                swap_int(begin, begin + l_size / 4);
+                swap_int(pivot_pos - 1, pivot_pos - l_size / 4);
+
+                if (l_size > PDQ_NINTHER_LIMIT) {
+                    swap_int(begin + 1, begin + (l_size / 4 + 1));
+                    swap_int(begin + 2, begin + (l_size / 4 + 2));
+                    swap_int(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                    swap_int(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                }
+            }
+
+            if (r_size >= PDQ_INSERTION_LIMIT) {
+                swap_int(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                swap_int(end - 1, end - r_size / 4);
+
+                if (r_size > PDQ_NINTHER_LIMIT) {
+                    swap_int(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                    swap_int(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                    swap_int(end - 2, end - (1 + r_size / 4));
+                    swap_int(end - 3, end - (2 + r_size / 4));
+                }
+            }
+        }
+
+        // Particao balanceada sem nenhuma troca: entrada provavelmente ja ordenada
+        else if (ja_particionado && pdq_partial_insertion(begin, pivot_pos)
+                                 && pdq_partial_insertion(pivot_pos + 1, end))
+            return;
+
+        pdq_loop(begin, pivot_pos, bad_allowed, leftmost);
+        begin = pivot_pos + 1;
+        leftmost = 0;
+    }
+}
+
+// Interface do pdqsort (algoritmo 5)
+void algoritmo_id5_pdqsort(int *array, int n) {
+    if (n <= 1)
+        return;
+
+    pdq_loop(array, array + n, ilog2(n), 1);
+}
+
+/************************** Introsort paralelo (roubo de trabalho) *********************************/
+// Cada thread possui um deque de tarefas [lo..hi]: o dono empilha/desempilha no topo (LIFO, boa localidade)
+// e as demais roubam da base (FIFO), onde ficam os maiores subarranjos ainda nao processados.
+// O resultado e identico ao sequencial: a ordenacao de inteiros e unica, logo o CRC32 nao muda.
+
+typedef struct {
+    int lo, hi, depth;
+} TarefaIntro;
+
+typedef struct {
+    TarefaIntro *itens;
+    int base, topo, cap;        // itens validos em [base, topo)
+    pthread_mutex_t trava;
+} DequeTarefas;
+
+typedef struct {
+    int *a;
+    int cutoff, nthreads;
+    DequeTarefas *deques;
+    atomic_int pendentes;       // tarefas criadas e ainda nao concluidas
+} PoolIntro;
+
+typedef struct {
+    PoolIntro *pool;
+    int id;
+} ArgTrabalhador;
+
+static void deque_push(DequeTarefas *d, TarefaIntro t) {
+    pthread_mutex_lock(&d->trava);
+
+    if (d->topo == d->cap) {
+        // Compacta antes de crescer: roubos liberam espaco na base
+        if (d->base > 0) {
+            memmove(d->itens, d->itens + d->base, (size_t)(d->topo - d->base) * sizeof(TarefaIntro));
+            d->topo -= d->base;
+            d->base = 0;
+        }
+
+        if (d->topo == d->cap) {
+            int cap = d->cap ? d->cap << 1 : 64;
+            TarefaIntro *novo = (TarefaIntro *)realloc(d->itens, (size_t)cap * sizeof(TarefaIntro));
+            if (novo == NULL) {
+                fprintf(stderr, "Erro de alocacao de memoria.\n");
+                exit(1);
+            }
+            d->itens = novo;
+            d->cap = cap;
+        }
+    }
+
+    d->itens[d->topo++] = t;
+    pthread_mutex_unlock(&d->trava);
+}
+
+// Retira do topo (uso exclusivo do dono do deque)
+static int deque_pop(DequeTarefas *d, TarefaIntro *t) {
+    int ok = 0;
+    pthread_mutex_lock(&d->trava);
+
+    if (d->topo > d->base) {
+        *t = d->itens[--d->topo];
+        ok = 1;
+    }
+
+    if (d->topo == d->base)
+        d->topo = d->base = 0;
+
+    pthread_mutex_unlock(&d->trava);
+    return ok;
+}
+
+// Retira da base (usado pelas threads ladras)
+static int deque_steal(DequeTarefas *d, TarefaIntro *t) {
+    int ok = 0;
+    pthread_mutex_lock(&d->trava);
+
+    if (d->topo > d->base) {
+        *t = d->itens[d->base++];
+        ok = 1;
+    }
+
+    if (d->topo == d->base)
+        d->topo = d->base = 0;
+
+    pthread_mutex_unlock(&d->trava);
+    return ok;
+}
+
+// Particiona enquanto a tarefa for maior que o cutoff, publicando a metade maior para roubo
+static void processa_tarefa(PoolIntro *pool, DequeTarefas *meu, TarefaIntro t) {
+    int *a = pool->a, lo = t.lo, hi = t.hi, depth = t.depth;
+
+    while (hi - lo + 1 > pool->cutoff && depth > 0) {
+        --depth;
+        int p = partition_hoare(a, lo, hi);
+        TarefaIntro outra;
+
+        if (p - lo < hi - (p + 1)) {
+            outra = (TarefaIntro){ p + 1, hi, depth };
+            hi = p;
+        }
+
+        else {
+            outra = (TarefaIntro){ lo, p, depth };
+            lo = p + 1;
+        }
+
+        atomic_fetch_add(&pool->pendentes, 1);
+        deque_push(meu, outra);
+    }
+
+    // Subarranjo pequeno (ou profundidade esgotada): introsort sequencial trata insertion/heapsort
+    if (lo < hi)
+        introsort_impl(a, lo, hi, depth);
+
+    atomic_fetch_sub(&pool->pendentes, 1);
+}
+
+static void *trabalhador_intro(void *arg) {
+    ArgTrabalhador *w = (ArgTrabalhador *)arg;
+    PoolIntro *pool = w->pool;
+    DequeTarefas *meu = &pool->deques[w->id];
+    TarefaIntro t;
+
+    for (;;) {
+        if (deque_pop(meu, &t)) {
+            processa_tarefa(pool, meu, t);
+            continue;
+        }
+
+        // Deque local vazio: tenta roubar das outras threads, comecando pela vizinha
+        int roubou = 0;
+        for (int k = 1; k < pool->nthreads && !roubou; ++k)
+            roubou = deque_steal(&pool->deques[(w->id + k) % pool->nthreads], &t);
+
+        if (roubou) {
+            processa_tarefa(pool, meu, t);
+            continue;
+        }
+
+        if (atomic_load(&pool->pendentes) == 0)
+            break; // nenhuma tarefa em andamento: todo o vetor esta ordenado
+
+        sched_yield();
+    }
+
+    return NULL;
+}
+
+// Interface do Introsort paralelo (algoritmo 3 com --threads)
+// nthreads <= 0 usa todos os nucleos online; cutoff e o tamanho minimo de tarefa que ainda e dividida
+void algoritmo_id3_introsort_paralelo(int *array, int n, int nthreads, int cutoff) {
+    if (nthreads <= 0) {
+        long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = (ncpu > 0) ? (int)ncpu : 1;
+    }
+
+    if (cutoff < 16)
+        cutoff = 16;
+
+    if (nthreads == 1 || n <= cutoff) {
+        algoritmo_id3_introsort(array, n);
+        return;
+    }
+
+    PoolIntro pool;
+    pool.a = array;
+    pool.cutoff = cutoff;
+    pool.nthreads = nthreads;
+    pool.deques = (DequeTarefas *)calloc((size_t)nthreads, sizeof(DequeTarefas));
+    pthread_t *threads = (pthread_t *)malloc((size_t)nthreads * sizeof(pthread_t));
+    ArgTrabalhador *args = (ArgTrabalhador *)malloc((size_t)nthreads * sizeof(ArgTrabalhador));
+
+    if (pool.deques == NULL || threads == NULL || args == NULL) {
         fprintf(stderr, "Erro de alocacao de memoria.\n");
-        return 1;
+        exit(1);
     }
 
-    // Geracao da sequencia
+    for (int i = 0; i < nthreads; ++i)
+        pthread_mutex_init(&pool.deques[i].trava, NULL);
+
+    // Tarefa raiz com o mesmo limite de profundidade do introsort sequencial
+    atomic_init(&pool.pendentes, 1);
+    deque_push(&pool.deques[0], (TarefaIntro){ 0, n - 1, ilog2(n) << 1 });
+
+    // A thread principal trabalha como a de id 0
+    for (int i = 0; i < nthreads; ++i) {
+        args[i].pool = &pool;
+        args[i].id = i;
+    }
+
+    for (int i = 1; i < nthreads; ++i)
+        pthread_create(&threads[i], NULL, trabalhador_intro, &args[i]);
+
+    trabalhador_intro(&args[0]);
+
+    for (int i = 1; i < nthreads; ++i)
+        pthread_join(threads[i], NULL);
+
+    for (int i = 0; i < nthreads; ++i) {
+        pthread_mutex_destroy(&pool.deques[i].trava);
+        free(pool.deques[i].itens);
+    }
+
+    free(pool.deques);
+    free(threads);
+    free(args);
+}
+
+// Preenche 'sequencia' conforme o tipo pedido (sorted/reverse/random; default random)
+typedef struct {
+    int *sequencia;
+    size_t inicio, fim;
+    int max;
+} FatiaGerador;
+
+static void *trabalhador_gerador(void *arg) {
+    FatiaGerador *f = (FatiaGerador *)arg;
+    get_random_fluxos(12345u, f->max, f->sequencia + f->inicio, f->inicio, f->fim - f->inicio);
+    return NULL;
+}
+
+// "streams": fluxos independentes por bloco; cada thread recebe uma faixa contigua de blocos,
+// entao o vetor gerado nao depende do numero de threads
+static void gerar_fluxos_paralelo(int *sequencia, int n, int nthreads) {
+    size_t blocos = ((size_t)n + XORSHIFT_BLOCO - 1) / XORSHIFT_BLOCO;
+
+    if (nthreads <= 0) {
+        long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = (ncpu > 0) ? (int)ncpu : 1;
+    }
+    if ((size_t)nthreads > blocos)
+        nthreads = blocos > 0 ? (int)blocos : 1;
+
+    if (nthreads == 1) {
+        get_random_fluxos(12345u, n, sequencia, 0, (size_t)n);
+        return;
+    }
+
+    pthread_t *threads = (pthread_t *)malloc((size_t)nthreads * sizeof(pthread_t));
+    FatiaGerador *fatias = (FatiaGerador *)malloc((size_t)nthreads * sizeof(FatiaGerador));
+    if (!threads || !fatias) {
+        free(threads);
+        free(fatias);
+        get_random_fluxos(12345u, n, sequencia, 0, (size_t)n);
+        return;
+    }
+
+    for (int t = 0; t < nthreads; t++) {
+        size_t b0 = blocos * (size_t)t / (size_t)nthreads;
+        size_t b1 = blocos * (size_t)(t + 1) / (size_t)nthreads;
+        fatias[t].sequencia = sequencia;
+        fatias[t].inicio = b0 * XORSHIFT_BLOCO;
+        fatias[t].fim = (b1 * XORSHIFT_BLOCO < (size_t)n) ? b1 * XORSHIFT_BLOCO : (size_t)n;
+        fatias[t].max = n;
+    }
+
+    for (int t = 1; t < nthreads; t++)
+        pthread_create(&threads[t], NULL, trabalhador_gerador, &fatias[t]);
+    trabalhador_gerador(&fatias[0]);
+    for (int t = 1; t < nthreads; t++)
+        pthread_join(threads[t], NULL);
+
+    free(threads);
+    free(fatias);
+}
+
+static void gerar_sequencia(int *sequencia, int n, const char *tipo_sequencia, int nthreads) {
     if (strcmp(tipo_sequencia, "sorted") == 0) {
         // Gera sequencia ja ordenada
         for (int i = 0; i < n; i++)
@@ -335,24 +982,21 @@ int main() {
 
     }
 
-    else if (strcmp(tipo_sequencia, "random") == 0) {
-        // Gera sequencia aleatoria usando a semente especificada
-        // get_random(state, max) devolve valores em [1..max]
-        int seed = 12345;
-        
-        for (int i = 0; i < n; i++)
-            sequencia[i] = get_random(&seed, n);
+    else if (strcmp(tipo_sequencia, "streams") == 0) {
+        // Aleatoria com fluxos xorshift independentes (SIMD + threads); outra sequencia, outro CRC
+        gerar_fluxos_paralelo(sequencia, n, nthreads);
     }
 
     else {
-        // Default seguro: random
+        // Gera sequencia aleatoria usando a semente especificada (tambem e o default seguro)
+        // get_random_lote equivale a n chamadas de get_random(state, max), valores em [1..max]
         int seed = 12345;
-
-        for (int i = 0; i < n; i++)
-            sequencia[i] = get_random(&seed, n);
+        get_random_lote(&seed, n, sequencia, (size_t)n);
     }
+}
 
-    // Selecao do algoritmo de ordenacao
+// Selecao do algoritmo de ordenacao; retorna 0 se o ID nao existe
+static int ordenar(int id_algoritmo, int *sequencia, int n, int nthreads, int cutoff) {
     switch (id_algoritmo) {
         case 1:
             algoritmo_id1_quicksort(sequencia, n);
@@ -363,14 +1007,160 @@ int main() {
             break;
 
         case 3:
-            algoritmo_id3_introsort(sequencia, n);
+            if (nthreads == 1)
+                algoritmo_id3_introsort(sequencia, n);
+            else
+                algoritmo_id3_introsort_paralelo(sequencia, n, nthreads, cutoff);
             break;
 
-        default:
-            printf("Algoritmo com ID %d nao implementado.\n", id_algoritmo);
+        case 4:
+            algoritmo_id4_radixsort_lsd(sequencia, n);
+            break;
+
+        case 5:
+            algoritmo_id5_pdqsort(sequencia, n);
             break;
+
+        default:
+            return 0;
+    }
+
+    return 1;
+}
+
+// Relogio de parede monotonico em segundos
+static double agora_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Modo benchmark: para cada tipo, n = 10^4..nmax (x10) e cada ID, imprime "tipo,n,alg,tempo,crc"
+// Geracao e CRC ficam fora da regiao cronometrada
+static int executar_bench(const char *ids, const char *tipos, long nmax, int nthreads, int cutoff) {
+    int *sequencia = (int *)malloc((size_t)(nmax > 0 ? nmax : 1) * sizeof(int));
+    if (sequencia == NULL) {
+        fprintf(stderr, "Erro de alocacao de memoria.\n");
+        return 1;
+    }
+
+    init_crc32();
+    printf("tipo,n,alg,tempo_s,crc32\n");
+
+    char tiposbuf[128];
+    strncpy(tiposbuf, tipos, sizeof(tiposbuf) - 1);
+    tiposbuf[sizeof(tiposbuf) - 1] = '\0';
+
+    for (char *tipo = strtok(tiposbuf, ","); tipo; tipo = strtok(NULL, ",")) {
+        // n = 0 primeiro: caso de borda do gerador e dos algoritmos (o CRC de entrada vazia e 00000000)
+        for (long long n = 0; n <= nmax; n = (n == 0) ? 10000 : n * 10) { // long long: n * 10 passa de INT_MAX
+            // IDs lidos com strtol (strtok ja esta em uso no laco dos tipos)
+            for (const char *p = ids; *p; ) {
+                char *fim;
+                int id = (int)strtol(p, &fim, 10);
+                if (fim == p)
+                    break;
+
+                p = (*fim == ',') ? fim + 1 : fim;
+
+                gerar_sequencia(sequencia, (int)n, tipo, nthreads);
+                double t0 = agora_s();
+                int ok = ordenar(id, sequencia, (int)n, nthreads, cutoff);
+                double t = agora_s() - t0;
+
+                if (!ok) {
+                    fprintf(stderr, "Algoritmo com ID %d nao implementado.\n", id);
+                    continue;
+                }
+
+                printf("%s,%lld,alg%d,%.6f,%08X\n", tipo, n, id, t, crc32(0, sequencia, (size_t)n * sizeof(int)));
+                fflush(stdout);
+            }
+        }
+    }
+
+    free(sequencia);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    // Opcoes do modo paralelo (o formato da entrada padrao nao muda)
+    int nthreads = 1, cutoff = 1 << 16;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            nthreads = atoi(argv[++i]);
+
+        else if (strcmp(argv[i], "--cutoff") == 0 && i + 1 < argc)
+            cutoff = atoi(argv[++i]);
+
+        else if (strcmp(argv[i], "--rede") == 0)
+            usar_rede = 1;
+    }
+
+    // Modo benchmark: --bench <ids> [tipos] [nmax]
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--bench") == 0 && i + 1 < argc) {
+            const char *tipos = (i + 2 < argc && argv[i + 2][0] != '-') ? argv[i + 2] : "random";
+            long nmax = 100000000L;
+            if (i + 3 < argc && strncmp(argv[i + 3], "--", 2) != 0) { // "-5" e valor (invalido), nao opcao
+                // os tamanhos viram int (gerar_sequencia, ordenar): fora de [0, INT_MAX] truncaria ou estouraria o malloc
+                char *fim;
+                nmax = strtol(argv[i + 3], &fim, 10);
+                if (*fim != '\0' || nmax < 0 || nmax > INT_MAX) {
+                    fprintf(stderr, "nmax invalido: %s (esperado 0..%d).\n", argv[i + 3], INT_MAX);
+                    return 1;
+                }
+            }
+            return executar_bench(argv[i + 1], tipos, nmax, nthreads, cutoff);
+        }
+    }
+
+    int n, id_algoritmo;
+    char tipo_sequencia[10];
+
+    // Leitura: usa %9s para evitar overflow do buffer de 'tipo_sequencia'
+    scanf("%d", &n);
+    scanf("%9s", tipo_sequencia);
+    scanf("%d", &id_algoritmo);
+
+    // Evita overflow de size_t e acesso invalido no CRC quando n < 0
+    if (n < 0) {
+        fprintf(stderr, "Valor de n invalido.\n");
+        return 1;
     }
 
+    int *sequencia = (int *)malloc((size_t)n * sizeof(int));
+    if (sequencia == NULL && n > 0) {
+        fprintf(stderr, "Erro de alocacao de memoria.\n");
+        return 1;
+    }
+
+    // Geracao da sequencia
+    gerar_sequencia(sequencia, n, tipo_sequencia, nthreads);
+
+    // Selecao do algoritmo de ordenacao
+#ifdef CONTADORES_HW
+    ContadoresHW contadores;
+    LeituraHW leitura;
+    contadores_abrir(&contadores);
+    contadores_iniciar(&contadores);
+#endif
+
+    if (!ordenar(id_algoritmo, sequencia, n, nthreads, cutoff))
+        printf("Algoritmo com ID %d nao implementado.\n", id_algoritmo);
+
+#ifdef CONTADORES_HW
+    // stdout continua so com o CRC; contadores vao para stderr (so a thread principal e medida)
+    contadores_parar(&contadores, &leitura);
+    contadores_fechar(&contadores);
+    fprintf(stderr, "alg,");
+    contadores_cabecalho_csv(stderr);
+    fprintf(stderr, "\nalg%d,", id_algoritmo);
+    contadores_imprimir_csv(stderr, &leitura);
+    fprintf(stderr, "\n");
+#endif
+
     // Hash de verificacao (independente do algoritmo), util para validar resultados em testes automatizados
     init_crc32(); // Inicializa a tabela de CRC32
     uint32_t saida = crc32(0, sequencia, (size_t)n * sizeof(int)); // Calcula o hash
@@ -380,4 +1170,4 @@ int main() {
     free(sequencia);
 
     return 0;
-}
\ No newline at end of file
+}
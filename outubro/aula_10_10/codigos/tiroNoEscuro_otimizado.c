@@ -1,8 +1,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
 #include <stdint.h> // Necessario para o tipo uint32_t usado em util.h
 #include "util.h"
+#include "rede_ordenacao.h"
 
 /*
     Programa geral de ordenacao:
@@ -15,13 +17,22 @@
       O(n log n) tipico, O(n^2) no pior caso (mitigado pela escolha do pivo).
     - Mergesort (bottom-up iterativo, com runs pequenas pre-ordenadas por insertion sort)
       O(n log n) no pior/medio/melhor, estavel; usa buffer auxiliar e alterna ponteiros (ping-pong).
+      Com --crc-incremental, o ultimo passe de merge alimenta o CRC32 bloco a bloco enquanto escreve,
+      dispensando a varredura separada de verificacao.
+      Com AVX2, runs de pelo menos MERGE_AVX2_LARGURA inteiros sao mescladas 8 a 8 por uma rede bitonica.
     - Heapsort (com construcao Floyd e cutoff para insertion na cauda pequena)
       O(n log n) no pior/medio/melhor; in-place, nao estavel.
+    - pdqsort (particionamento em blocos sem desvios + deteccao de padroes, fallback para o heapsort acima)
+      O(n) em entradas ordenadas/invertidas, O(n log n) no pior caso; in-place, nao estavel.
+    - --rede: o cutoff de insertion sort (quicksort, runs do mergesort, cauda do heapsort, pdqsort) passa a usar
+      as redes de ordenacao de rede_ordenacao.h (8/16/32 ints, AVX2 quando disponivel); o CRC nao muda.
 */
 
 void algoritmo_id1_quicksort(int *array, int n);
 void algoritmo_id2_mergesort(int *array, int n);
+uint32_t algoritmo_id2_mergesort_crc(int *array, int n);
 void algoritmo_id3_heapsort(int *array, int n);
+void algoritmo_id4_pdqsort(int *array, int n);
 
 // Troca simples de dois inteiros por referencia
 static void swap_int(int *a, int *b) {
@@ -49,6 +60,16 @@ static void insertion_sort(int *a, int lo, int hi) {
     }
 }
 
+// Cutoff dos hibridos (no maximo REDE_MAXIMO elementos): insertion sort ou, com --rede, rede de ordenacao
+static int usar_rede = 0;
+
+static void cutoff_sort(int *a, int lo, int hi) {
+    if (usar_rede)
+        rede_ordenar(a + lo, hi - lo + 1);
+    else
+        insertion_sort(a, lo, hi);
+}
+
 // Escolha de pivo por mediana de tres: a[lo], a[mid], a[hi]
 // Reduz a chance de piores casos em entradas quase ordenadas
 static int median_of_three(int *a, int lo, int hi) {
@@ -106,7 +127,7 @@ static void quicksort_impl(int *a, int lo, int hi) {
     // - Recursao sempre na menor metade (eliminacao de recursao de cauda), limitando profundidade para O(log n)
     while (lo < hi) {
         if (hi - lo + 1 <= 16) { // cutoff para pequenos subarrays (valor empirico)
-            insertion_sort(a, lo, hi);
+            cutoff_sort(a, lo, hi);
             break;
         }
         
@@ -160,54 +181,161 @@ static void reverse_array(int *a, int n) {
         swap_int(&a[i], &a[j]);
 }
 
+// Kernel AVX2 do merge: so para runs com pelo menos MERGE_AVX2_LARGURA inteiros
+#define MERGE_AVX2_LARGURA 32
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+// Merge de 8 em 8 (Inoue et al.): a (8 do proximo bloco) e b (8 pendentes) passam pela rede bitonica de 16;
+// os 8 menores saem para dst e os 8 maiores ficam pendentes. O proximo bloco vem do lado de menor cabeca,
+// o unico desvio por passo (em vez de um por elemento). Para quando esse lado tem menos de 8; os pendentes
+// sao mesclados com as cabecas restantes e o merge escalar termina o resto. Com ints sem dado satelite,
+// o resultado e identico ao do merge estavel.
+// Avanca *p em [.., mid), *q em [.., right) e devolve o novo k; para tambem quando k passa de 'limite'.
+__attribute__((target("avx2")))
+static size_t merge_avx2(const int *src, int *dst, size_t *pp, size_t *pq, size_t k, size_t mid, size_t right,
+                         size_t limite) {
+    size_t p = *pp, q = *pq;
+    if (mid - p < 8 || right - q < 8)
+        return k;
+
+    __m256i a = _mm256_loadu_si256((const __m256i *)&src[p]);
+    __m256i b = _mm256_loadu_si256((const __m256i *)&src[q]);
+    p += 8;
+    q += 8;
+
+    for (;;) {
+        rede_merge16_avx2(&a, &b); // a: 8 menores, b: 8 maiores
+        _mm256_storeu_si256((__m256i *)&dst[k], a);
+        k += 8;
+
+        if (k >= limite)
+            break;
+
+        if (p < mid && (q >= right || src[p] <= src[q])) {
+            if (mid - p < 8)
+                break;
+            a = _mm256_loadu_si256((const __m256i *)&src[p]);
+            p += 8;
+        }
+        else {
+            if (right - q < 8)
+                break;
+            a = _mm256_loadu_si256((const __m256i *)&src[q]);
+            q += 8;
+        }
+    }
+
+    // Pendentes (ja ordenados) contra as cabecas dos dois lados, ate esgotarem
+    int pendente[8];
+    _mm256_storeu_si256((__m256i *)pendente, b);
+    for (int r = 0; r < 8; ) {
+        if (p < mid && src[p] <= pendente[r] && (q >= right || src[p] <= src[q]))
+            dst[k++] = src[p++];
+        else if (q < right && src[q] < pendente[r])
+            dst[k++] = src[q++];
+        else
+            dst[k++] = pendente[r++];
+    }
+
+    *pp = p;
+    *pq = q;
+    return k;
+}
+#endif
+
+// Merge estavel de [left..mid) e [mid..right) de src em dst, com o CRC32 da saida calculado
+// em blocos de CRC_BLOCO inteiros logo apos serem escritos (ainda quentes no cache)
+#define CRC_BLOCO 4096
+
+static uint32_t merge_com_crc(const int *src, int *dst, size_t left, size_t mid, size_t right, uint32_t crc) {
+    size_t p = left, q = mid, k = left;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    int usa_avx2 = rede_usa_avx2();
+#endif
+
+    while (p < mid && q < right) {
+        size_t inicio = k, fim = k + CRC_BLOCO;
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        if (usa_avx2 && mid - left >= MERGE_AVX2_LARGURA)
+            k = merge_avx2(src, dst, &p, &q, k, mid, right, fim);
+#endif
+
+        while (k < fim && p < mid && q < right) {
+            if (src[p] <= src[q])
+                dst[k++] = src[p++];
+
+            else
+                dst[k++] = src[q++];
+        }
+
+        crc = crc32(crc, &dst[inicio], (k - inicio) * sizeof(int));
+    }
+
+    // Restante de um dos lados: copia e hash de uma vez
+    size_t resto = (p < mid) ? mid - p : right - q;
+    memcpy(&dst[k], (p < mid) ? &src[p] : &src[q], resto * sizeof(int));
+    return crc32(crc, &dst[k], resto * sizeof(int));
+}
+
 // Mergesort iterativo (bottom-up) hibridizado com insertion sort para runs pequenas
 // - Pre-ordena runs de tamanho RUN com insertion sort
 // - Faz merge em "ping-pong" entre array e tmp, copiando ao final so se necessario
-void algoritmo_id2_mergesort(int *array, int n) {
+// Se 'crc_out' nao e NULL, o ultimo passe calcula o CRC32 do resultado (init_crc32 ja chamado).
+// Retorna 1 se o CRC foi calculado durante o merge; 0 nos atalhos que terminam sem passe final.
+static int mergesort_impl(int *array, int n, uint32_t *crc_out) {
     // Versao iterativa (bottom-up) com runs pequenas otimizadas via insertion sort (melhora localidade e cache).
+    int hash_feito = 0;
+
     if (n <= 1) 
-        return;
+        return 0;
 
     // Fast-paths: ja ordenado crescente ou totalmente decrescente
     if (is_sorted_asc(array, n)) 
-        return;
+        return 0;
 
     if (is_sorted_desc(array, n)) { 
         reverse_array(array, n); 
-        return; 
+        return 0; 
     }
 
     size_t N = (size_t)n;
 
-    // Pre-ordena runs pequenas com insertion sort
+    // Pre-ordena runs pequenas com insertion sort (ou rede de ordenacao, com --rede)
     const size_t RUN = 32; // tamanho de run escolhido empiricamente; ajustavel conforme arquitetura e dados
 
     for (size_t i = 0; i < N; i += RUN) {
         size_t lo = i;
         size_t hi = (i + RUN - 1 < N) ? (i + RUN - 1) : (N - 1);
-        insertion_sort(array, (int)lo, (int)hi);
+        cutoff_sort(array, (int)lo, (int)hi);
     }
 
     // Se ja coube tudo em uma run, ja esta ordenado
-    if (N <= RUN) return;
+    if (N <= RUN) 
+        return 0;
 
     int *tmp = (int *)malloc(N * sizeof(int));
 
     int *src = array, *dst = tmp;
     size_t width = RUN;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    int usa_avx2 = rede_usa_avx2();
+#endif
     while (width < N) {
         // Pre-checagem: se todas as fronteiras de runs ja estao em ordem, termina
         // Evita passes de merge desnecessarios quando quase tudo ja esta mesclado
+        // (todas as fronteiras, nao so as do meio de cada par: as entre pares tambem precisam estar em ordem)
         int already_sorted = 1;
 
-        for (size_t i = 0; i + width < N; i += (width << 1)) {
-            size_t mid = i + width;
+        for (size_t mid = width; mid < N; mid += width) {
             if (src[mid - 1] > src[mid]) { already_sorted = 0; break; }
         }
 
         if (already_sorted) break;
 
-        int any_merged = 0;
+        // Ultimo passe: um unico merge cobre [0, N)
+        int ultimo = crc_out != NULL && (width << 1) >= N;
+
         for (size_t i = 0; i < N; i += (width << 1)) {
             size_t left = i, mid = i + width, right = i + (width << 1);
             if (mid > N)
@@ -222,9 +350,19 @@ void algoritmo_id2_mergesort(int *array, int n) {
                 continue;
             }
 
+            if (ultimo) {
+                *crc_out = merge_com_crc(src, dst, left, mid, right, 0);
+                hash_feito = 1;
+                continue;
+            }
+
             // Merge estavel src -> dst
             // Invariante: [left..mid) e [mid..right) estao ordenados em src
             size_t p = left, q = mid, k = left;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+            if (usa_avx2 && width >= MERGE_AVX2_LARGURA)
+                k = merge_avx2(src, dst, &p, &q, k, mid, right, right);
+#endif
             while (p < mid && q < right) {
                 if (src[p] <= src[q]) 
                     dst[k++] = src[p++];
@@ -239,13 +377,11 @@ void algoritmo_id2_mergesort(int *array, int n) {
 
             while (q < right) 
                 dst[k++] = src[q++];
-
-            any_merged = 1;
         }
 
-        if (!any_merged) break; // nada a mesclar neste passe
-
         // Proximo passe: troca src/dst (ping-pong). Evita copias desnecessarias a cada nivel.
+        // Mesmo que nenhum par tenha precisado de merge, dst recebeu a copia e as fronteiras fora de ordem
+        // (entre pares) ficam para o passe seguinte.
         int *swap = src; src = dst; dst = swap;
 
         if (width > (N >> 1)) break;     // evita overflow ao dobrar
@@ -257,6 +393,22 @@ void algoritmo_id2_mergesort(int *array, int n) {
         memcpy(array, src, N * sizeof(int));
 
     free(tmp);
+    return hash_feito;
+}
+
+void algoritmo_id2_mergesort(int *array, int n) {
+    mergesort_impl(array, n, NULL);
+}
+
+// Mergesort que devolve o CRC32 do vetor ordenado, calculado durante o ultimo passe de merge
+uint32_t algoritmo_id2_mergesort_crc(int *array, int n) {
+    uint32_t crc = 0;
+
+    // Sem passe final (entrada ja ordenada/invertida ou pequena): hash sobre o vetor
+    if (!mergesort_impl(array, n, &crc))
+        crc = crc32(0, array, (size_t)(n > 0 ? n : 0) * sizeof(int));
+
+    return crc;
 }
 
 // Restaura a propriedade de heap maximo a partir do indice i em um heap de tamanho n
@@ -315,7 +467,7 @@ void algoritmo_id3_heapsort(int *array, int n) {
 
     // Cutoff para tamanhos pequenos: insertion sort e tipicamente melhor em cache
     if (n <= 32) {
-        insertion_sort(array, 0, n - 1);
+        cutoff_sort(array, 0, n - 1);
         return;
     }
 
@@ -327,7 +479,7 @@ void algoritmo_id3_heapsort(int *array, int n) {
     // Cutoff: termina com insertion sort quando a cauda for pequena
     for (int end = n - 1; end > 0; --end) {
         if (end < 32) { // ordena o prefixo restante de forma eficiente
-            insertion_sort(array, 0, end);
+            cutoff_sort(array, 0, end);
             break;
         }
 
@@ -338,7 +490,318 @@ void algoritmo_id3_heapsort(int *array, int n) {
     }
 }
 
-int main() {
+// log2 inteiro de n (n > 0); limite de particoes ruins do pdqsort
+static int ilog2(int n) {
+    int lg = 0;
+    while (n > 1) { n >>= 1; ++lg; }
+    return lg;
+}
+
+/************************** Pattern-defeating quicksort (particionamento em blocos) *********************************/
+// Baseado no pdqsort (Orson Peters) e no BlockQuicksort (Edelkamp e Weiss):
+// - Particionamento sem desvios: os indices de elementos do lado errado sao gravados em buffers de
+//   deslocamento (offsets) de PDQ_BLOCK posicoes e trocados depois, sem branch dependente do dado
+// - Deteccao de particao ja feita: se nenhuma troca foi necessaria, tenta terminar com insertion sort parcial
+// - Pivos iguais ao anterior agrupam os repetidos a esquerda (partition_left) e pulam essa parte
+// - Particoes muito desbalanceadas embaralham alguns elementos; apos log2(n) delas, cai para heapsort
+#define PDQ_INSERTION_LIMIT 24
+#define PDQ_NINTHER_LIMIT 128
+#define PDQ_PARTIAL_INSERTION_LIMIT 8
+#define PDQ_BLOCK 64
+
+static void pdq_sort2(int *a, int *b) {
+    if (*b < *a)
+        swap_int(a, b);
+}
+
+static void pdq_sort3(int *a, int *b, int *c) {
+    pdq_sort2(a, b);
+    pdq_sort2(b, c);
+    pdq_sort2(a, b);
+}
+
+// Insertion sort sem guarda em [begin, end): exige que *(begin - 1) seja <= todos os elementos
+static void pdq_insertion_unguarded(int *begin, int *end) {
+    for (int *cur = begin + 1; cur < end; ++cur) {
+        int *sift = cur, *sift_1 = cur - 1;
+
+        if (*sift < *sift_1) {
+            int tmp = *sift;
+
+            do {
+                *sift-- = *sift_1;
+            } while (tmp < *--sift_1);
+
+            *sift = tmp;
+        }
+    }
+}
+
+// Insertion sort que desiste apos PDQ_PARTIAL_INSERTION_LIMIT deslocamentos; retorna 1 se ordenou tudo
+static int pdq_partial_insertion(int *begin, int *end) {
+    size_t limit = 0;
+
+    for (int *cur = begin + 1; cur < end; ++cur) {
+        int *sift = cur, *sift_1 = cur - 1;
+
+        if (*sift < *sift_1) {
+            int tmp = *sift;
+
+            do {
+                *sift-- = *sift_1;
+            } while (sift != begin && tmp < *--sift_1);
+
+            *sift = tmp;
+            limit += (size_t)(cur - sift);
+        }
+
+        if (limit > PDQ_PARTIAL_INSERTION_LIMIT)
+            return 0;
+    }
+
+    return 1;
+}
+
+// Troca os pares (first + offsets_l[i], last - offsets_r[i]); sem 'use_swaps' faz um ciclo com uma so copia temporaria
+static void pdq_swap_offsets(int *first, int *last, const unsigned char *offsets_l,
+                             const unsigned char *offsets_r, size_t num, int use_swaps) {
+    if (use_swaps) {
+        // Necessario na distribuicao decrescente para o pdqsort continuar O(n)
+        for (size_t i = 0; i < num; ++i)
+            swap_int(first + offsets_l[i], last - offsets_r[i]);
+    }
+
+    else if (num > 0) {
+        int *l = first + offsets_l[0], *r = last - offsets_r[0];
+        int tmp = *l;
+        *l = *r;
+
+        for (size_t i = 1; i < num; ++i) {
+            l = first + offsets_l[i];
+            *r = *l;
+            r = last - offsets_r[i];
+            *l = *r;
+        }
+
+        *r = tmp;
+    }
+}
+
+// Particiona [begin, end) em torno de *begin: [< pivo] pivo [>= pivo]
+// Retorna a posicao final do pivo; *ja_particionado indica que nenhuma troca foi feita
+static int *pdq_partition_right_branchless(int *begin, int *end, int *ja_particionado) {
+    int pivot = *begin, *first = begin, *last = end;
+
+    // Primeiro elemento >= pivo (existe pela mediana de tres)
+    while (*++first < pivot);
+
+    // Primeiro elemento < pivo vindo da direita; precisa de guarda se nao ha nada antes de *first
+    if (first - 1 == begin)
+        while (first < last && !(*--last < pivot));
+    else
+        while (!(*--last < pivot));
+
+    *ja_particionado = first >= last;
+
+    if (!*ja_particionado) {
+        swap_int(first, last);
+        ++first;
+
+        unsigned char offsets_l[PDQ_BLOCK], offsets_r[PDQ_BLOCK];
+        int *offsets_l_base = first, *offsets_r_base = last;
+        size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+        while (first < last) {
+            // Quantos elementos cada bloco de offsets ainda vai examinar
+            size_t num_unknown = (size_t)(last - first);
+            size_t left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+            size_t right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+
+            // Preenche os offsets: o indice e sempre escrito, o contador so avanca se o elemento estiver errado
+            if (left_split > PDQ_BLOCK)
+                left_split = PDQ_BLOCK;
+
+            for (size_t i = 0; i < left_split; ++i) {
+                offsets_l[num_l] = (unsigned char)i;
+                num_l += !(*first < pivot);
+                ++first;
+            }
+
+            if (right_split > PDQ_BLOCK)
+                right_split = PDQ_BLOCK;
+
+            for (size_t i = 0; i < right_split; ) {
+                offsets_r[num_r] = (unsigned char)++i;
+                num_r += *--last < pivot;
+            }
+
+            // Troca o que for possivel e atualiza os blocos
+            size_t num = num_l < num_r ? num_l : num_r;
+            pdq_swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l, offsets_r + start_r,
+                             num, num_l == num_r);
+            num_l -= num;
+            num_r -= num;
+            start_l += num;
+            start_r += num;
+
+            if (num_l == 0) {
+                start_l = 0;
+                offsets_l_base = first;
+            }
+
+            if (num_r == 0) {
+                start_r = 0;
+                offsets_r_base = last;
+            }
+        }
+
+        // Sobrou um bloco com elementos do lado errado: leva-os para a fronteira
+        if (num_l) {
+            while (num_l--)
+                swap_int(offsets_l_base + offsets_l[start_l + num_l], --last);
+            first = last;
+        }
+
+        if (num_r) {
+            while (num_r--) {
+                swap_int(offsets_r_base - offsets_r[start_r + num_r], first);
+                ++first;
+            }
+            last = first;
+        }
+    }
+
+    // Coloca o pivo na posicao final
+    int *pivot_pos = first - 1;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pivot_pos;
+}
+
+// Particiona [begin, end) em [<= pivo] pivo [> pivo]; usado quando o pivo repete o elemento anterior
+static int *pdq_partition_left(int *begin, int *end) {
+    int pivot = *begin, *first = begin, *last = end;
+
+    while (pivot < *--last);
+
+    if (last + 1 == end)
+        while (first < last && !(pivot < *++first));
+    else
+        while (!(pivot < *++first));
+
+    while (first < last) {
+        swap_int(first, last);
+        while (pivot < *--last);
+        while (!(pivot < *++first));
+    }
+
+    *begin = *last;
+    *last = pivot;
+    return last;
+}
+
+static void pdq_loop(int *begin, int *end, int bad_allowed, int leftmost) {
+    // Laco para eliminar a recursao de cauda na particao direita
+    for (;;) {
+        ptrdiff_t size = end - begin;
+
+        if (size < PDQ_INSERTION_LIMIT) {
+            if (leftmost || usar_rede) // a rede nao depende da sentinela a esquerda
+                cutoff_sort(begin, 0, (int)size - 1);
+            else
+                pdq_insertion_unguarded(begin, end);
+            return;
+        }
+
+        // Pivo: mediana de tres ou pseudomediana de nove (ninther)
+        ptrdiff_t s2 = size / 2;
+        if (size > PDQ_NINTHER_LIMIT) {
+            pdq_sort3(begin, begin + s2, end - 1);
+            pdq_sort3(begin + 1, begin + (s2 - 1), end - 2);
+            pdq_sort3(begin + 2, begin + (s2 + 1), end - 3);
+            pdq_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1));
+            swap_int(begin, begin + s2);
+        }
+
+        else
+            pdq_sort3(begin + s2, begin, end - 1);
+
+        // *(begin - 1) e o pivo de uma particao anterior e nenhum elemento aqui e menor que ele.
+        // Se o novo pivo e igual, todos os iguais vao para a esquerda e ja estao no lugar.
+        if (!leftmost && !(*(begin - 1) < *begin)) {
+            begin = pdq_partition_left(begin, end) + 1;
+            continue;
+        }
+
+        int ja_particionado;
+        int *pivot_pos = pdq_partition_right_branchless(begin, end, &ja_particionado);
+
+        ptrdiff_t l_size = pivot_pos - begin, r_size = end - (pivot_pos + 1);
+        int desbalanceado = l_size < size / 8 || r_size < size / 8;
+
+        if (desbalanceado) {
+            // Muitas particoes ruins: heapsort garante O(n log n)
+            if (--bad_allowed == 0) {
+                algoritmo_id3_heapsort(begin, (int)size);
+                return;
+            }
+
+            // Embaralha alguns elementos para quebrar padroes que enganam a escolha do pivo
+            if (l_size >= PDQ_INSERTION_LIMIT) {
+                swap_int(begin, begin + l_size / 4);
+                swap_int(pivot_pos - 1, pivot_pos - l_size / 4);
+
+                if (l_size > PDQ_NINTHER_LIMIT) {
+                    swap_int(begin + 1, begin + (l_size / 4 + 1));
+                    swap_int(begin + 2, begin + (l_size / 4 + 2));
+                    swap_int(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                    swap_int(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                }
+            }
+
+            if (r_size >= PDQ_INSERTION_LIMIT) {
+                swap_int(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                swap_int(end - 1, end - r_size / 4);
+
+                if (r_size > PDQ_NINTHER_LIMIT) {
+                    swap_int(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                    swap_int(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                    swap_int(end - 2, end - (1 + r_size / 4));
+                    swap_int(end - 3, end - (2 + r_size / 4));
+                }
+            }
+        }
+
+        // Particao balanceada sem nenhuma troca: entrada provavelmente ja ordenada
+        else if (ja_particionado && pdq_partial_insertion(begin, pivot_pos)
+                                 && pdq_partial_insertion(pivot_pos + 1, end))
+            return;
+
+        pdq_loop(begin, pivot_pos, bad_allowed, leftmost);
+        begin = pivot_pos + 1;
+        leftmost = 0;
+    }
+}
+
+// Interface do pdqsort (algoritmo 4)
+void algoritmo_id4_pdqsort(int *array, int n) {
+    if (n <= 1)
+        return;
+
+    pdq_loop(array, array + n, ilog2(n), 1);
+}
+
+int main(int argc, char *argv[]) {
+    // --crc-incremental: no mergesort (ID 2), o CRC sai do ultimo passe de merge
+    // --rede: redes de ordenacao no lugar do insertion sort do cutoff
+    int crc_incremental = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--crc-incremental") == 0)
+            crc_incremental = 1;
+        else if (strcmp(argv[i], "--rede") == 0)
+            usar_rede = 1;
+    }
+
     int n, id_algoritmo;
     char tipo_sequencia[10];
 
@@ -388,6 +851,10 @@ int main() {
             sequencia[i] = get_random(&seed, n);
     }
 
+    init_crc32(); // Inicializa a tabela de CRC32
+    uint32_t saida = 0;
+    int saida_pronta = 0;
+
     // Selecao do algoritmo de ordenacao
     switch (id_algoritmo) {
         case 1:
@@ -395,21 +862,30 @@ int main() {
             break;
 
         case 2:
-            algoritmo_id2_mergesort(sequencia, n);
+            if (crc_incremental) {
+                saida = algoritmo_id2_mergesort_crc(sequencia, n);
+                saida_pronta = 1;
+            }
+            else
+                algoritmo_id2_mergesort(sequencia, n);
             break;
 
         case 3:
             algoritmo_id3_heapsort(sequencia, n);
             break;
 
+        case 4:
+            algoritmo_id4_pdqsort(sequencia, n);
+            break;
+
         default:
             printf("Algoritmo com ID %d nao implementado.\n", id_algoritmo);
             break;
     }
 
     // Hash de verificacao (independente do algoritmo), util para validar resultados em testes automatizados
-    init_crc32(); // Inicializa a tabela de CRC32
-    uint32_t saida = crc32(0, sequencia, (size_t)n * sizeof(int)); // Calcula o hash
+    if (!saida_pronta)
+        saida = crc32(0, sequencia, (size_t)n * sizeof(int)); // Calcula o hash
     printf("%08X\n", saida); // Imprime a saida no formato hexadecimal
 
     // Libera recursos
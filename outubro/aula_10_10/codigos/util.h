@@ -7,6 +7,12 @@
 /*
     util.h
     - Rotinas auxiliares compartilhadas: CRC32 (hash) e gerador pseudoaleatório xorshift32.
+    - CRC32 com slice-by-8 e, em x86 com PCLMULQDQ (detectado em tempo de execução), dobramento por
+      multiplicação sem carry; ambos produzem exatamente o mesmo valor da tabela byte a byte.
+    - get_random_lemire: mesmo gerador, mapeamento para [1..max] sem viés e sem divisão (multiply-shift).
+    - Gerador em lote: get_random_lote reproduz a sequência de get_random (modo legado, mesmos hashes);
+      get_random_fluxos preenche com 8 fluxos xorshift32 independentes por bloco (AVX2 quando disponível),
+      divisível entre threads sem alterar o resultado.
     - Fornece funções usadas pelo programa principal para verificação (hash) e geração de entradas.
 */
 
@@ -15,6 +21,12 @@
 // Tabela de 256 entradas para o CRC-32 (polinômio padrão 0xEDB88320, refletido)
 uint32_t crc32_table[256];
 
+// Tabelas do slice-by-8: crc32_slice[k][b] = CRC de b seguido de k bytes zero (crc32_slice[0] == crc32_table)
+static uint32_t crc32_slice[8][256];
+
+// 1 quando a CPU suporta PCLMULQDQ + SSE4.1 (detectado em init_crc32)
+static int crc32_usa_clmul = 0;
+
 void init_crc32() {
     // Pré-computa a tabela do CRC-32 para acelerar o processamento byte a byte.
     uint32_t poly = 0xEDB88320;
@@ -28,15 +40,136 @@ void init_crc32() {
         }
         crc32_table[i] = c;
     }
+
+    // Tabelas derivadas: avançar um byte zero equivale a um passo da tabela base
+    for (int i = 0; i < 256; i++) {
+        uint32_t c = crc32_table[i];
+        crc32_slice[0][i] = c;
+        for (int k = 1; k < 8; k++) {
+            c = crc32_table[c & 0xFF] ^ (c >> 8);
+            crc32_slice[k][i] = c;
+        }
+    }
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    crc32_usa_clmul = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+#endif
+}
+
+// Slice-by-8: 8 bytes por iteração com 8 consultas independentes (estado interno, já invertido)
+static uint32_t crc32_slice8(uint32_t crc, const unsigned char *p, size_t size) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    while (size >= 8) {
+        uint32_t um, dois;
+        memcpy(&um, p, 4);
+        memcpy(&dois, p + 4, 4);
+        um ^= crc;
+        crc = crc32_slice[7][um & 0xFF] ^ crc32_slice[6][(um >> 8) & 0xFF] ^
+              crc32_slice[5][(um >> 16) & 0xFF] ^ crc32_slice[4][um >> 24] ^
+              crc32_slice[3][dois & 0xFF] ^ crc32_slice[2][(dois >> 8) & 0xFF] ^
+              crc32_slice[1][(dois >> 16) & 0xFF] ^ crc32_slice[0][dois >> 24];
+        p += 8;
+        size -= 8;
+    }
+#endif
+    while (size--)
+        crc = crc32_table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+
+// Dobramento com multiplicação sem carry (Intel, "Fast CRC Computation Using PCLMULQDQ"):
+// 4 acumuladores de 128 bits avançam 64 bytes por iteração e são reduzidos a 32 bits por Barrett.
+// Exige size >= 64 e múltiplo de 16; recebe e devolve o estado interno (já invertido).
+__attribute__((target("pclmul,sse4.1")))
+static uint32_t crc32_clmul(uint32_t crc, const unsigned char *buf, size_t size) {
+    // Constantes do domínio refletido para 0xEDB88320 (x^(4*128+32), x^(4*128-32), x^(128+32), ...)
+    const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596LL, 0x0154442bd4LL);
+    const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009eLL, 0x01751997d0LL);
+    const __m128i k5k0 = _mm_set_epi64x(0, 0x0163cd6124LL);
+    const __m128i poly = _mm_set_epi64x(0x01f7011641LL, 0x01db710641LL);
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+    __m128i x1 = _mm_loadu_si128((const __m128i *)(buf + 0x00));
+    __m128i x2 = _mm_loadu_si128((const __m128i *)(buf + 0x10));
+    __m128i x3 = _mm_loadu_si128((const __m128i *)(buf + 0x20));
+    __m128i x4 = _mm_loadu_si128((const __m128i *)(buf + 0x30));
+    __m128i x5;
+
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+    buf += 64;
+    size -= 64;
+
+    // Dobra 4 blocos de 128 bits em paralelo
+    while (size >= 64) {
+        __m128i l1 = _mm_clmulepi64_si128(x1, k1k2, 0x00), h1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+        __m128i l2 = _mm_clmulepi64_si128(x2, k1k2, 0x00), h2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+        __m128i l3 = _mm_clmulepi64_si128(x3, k1k2, 0x00), h3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+        __m128i l4 = _mm_clmulepi64_si128(x4, k1k2, 0x00), h4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+
+        x1 = _mm_xor_si128(_mm_xor_si128(h1, l1), _mm_loadu_si128((const __m128i *)(buf + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(h2, l2), _mm_loadu_si128((const __m128i *)(buf + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(h3, l3), _mm_loadu_si128((const __m128i *)(buf + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(h4, l4), _mm_loadu_si128((const __m128i *)(buf + 0x30)));
+
+        buf += 64;
+        size -= 64;
+    }
+
+    // Reduz os 4 acumuladores a um só
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x4), x5);
+
+    // Blocos restantes de 16 bytes
+    while (size >= 16) {
+        x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((const __m128i *)buf)), x5);
+        buf += 16;
+        size -= 16;
+    }
+
+    // 128 -> 64 bits
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k5k0, 0x00), x2);
+
+    // Redução de Barrett para 32 bits
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return (uint32_t)_mm_extract_epi32(x1, 1);
 }
+#endif
 
 uint32_t crc32(uint32_t crc, const void *buf, size_t size) {
     // Calcula o CRC-32 (refletido) do buffer 'buf' com tamanho 'size' bytes.
     // 'crc' permite encadear chamadas (iniciar com 0 para hash simples).
+    // Caminho PCLMULQDQ para a parte múltipla de 16 (quando disponível) e slice-by-8 para o resto;
+    // o resultado é idêntico ao da versão byte a byte.
     const unsigned char *p = (const unsigned char *)buf;
     crc = crc ^ ~0U;
-    while (size--)
-        crc = crc32_table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    if (crc32_usa_clmul && size >= 64) {
+        size_t bloco = size & ~(size_t)15;
+        crc = crc32_clmul(crc, p, bloco);
+        p += bloco;
+        size -= bloco;
+    }
+#endif
+    crc = crc32_slice8(crc, p, size);
     return crc ^ ~0U;
 }
 
@@ -53,3 +186,166 @@ int get_random(int *state, int max) {
     *state = x; // atualiza o estado externo (reentrante via ponteiro)
     return (int)((x % max) + 1);
 }
+
+// Variante sem viés e sem divisão no caminho comum (Lemire, multiply-shift com rejeição):
+// o produto de 64 bits x * max tem a parte alta uniforme em [0..max) depois de rejeitar os poucos x cuja
+// parte baixa cai abaixo de 2^32 mod max. A divisão só acontece quando a parte baixa < max (prob. max / 2^32).
+// Mesma interface de get_random ([1..max], estado via ponteiro): a escolha é feita em cada chamada.
+// Consome a mesma sequência xorshift, mas mapeia de outro jeito (e às vezes rejeita): resultados diferentes.
+static inline int get_random_lemire(int *state, int max) {
+    uint32_t x = (uint32_t) *state;
+    uint32_t range = (uint32_t)max;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    uint64_t m = (uint64_t)x * range;
+    uint32_t baixo = (uint32_t)m;
+
+    if (baixo < range) {
+        uint32_t limiar = (0u - range) % range; // 2^32 mod max
+        while (baixo < limiar) {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            m = (uint64_t)x * range;
+            baixo = (uint32_t)m;
+        }
+    }
+
+    *state = (int)x;
+    return (int)(m >> 32) + 1;
+}
+
+// Resto exato x % d sem divisão (Lemire, "fastmod"): M = ceil(2^64 / d), x % d = ((M * x) mod 2^64) * d / 2^64.
+// Vale para quaisquer x, d de 32 bits (d > 0); o custo da divisão fica só no cálculo de M, uma vez por lote.
+static inline uint64_t xorshift_fastmod_m(uint32_t d) {
+    return UINT64_C(0xFFFFFFFFFFFFFFFF) / d + 1;
+}
+
+static inline uint32_t xorshift_fastmod(uint32_t x, uint64_t m, uint32_t d) {
+#ifdef __SIZEOF_INT128__
+    return (uint32_t)(((unsigned __int128)(m * x) * d) >> 64);
+#else
+    (void)m;
+    return x % d;
+#endif
+}
+
+// Modo legado em lote: mesmo resultado de n chamadas a get_random(state, max), inclusive o estado final.
+// O estado fica em registrador e o módulo vira multiplicação; a recorrência continua serial.
+static inline void get_random_lote(int *state, int max, int *dst, size_t n) {
+    // Sem valores a sortear (ou faixa vazia): sai antes de calcular M, que dividiria por zero
+    if (n == 0 || max <= 0)
+        return;
+
+    uint32_t x = (uint32_t) *state;
+    uint64_t m = xorshift_fastmod_m((uint32_t)max);
+
+    for (size_t i = 0; i < n; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        dst[i] = (int)(xorshift_fastmod(x, m, (uint32_t)max) + 1);
+    }
+
+    *state = (int)x;
+}
+
+// ---------- Fluxos independentes ----------
+// O vetor é dividido em blocos de XORSHIFT_BLOCO valores; o bloco b usa XORSHIFT_FLUXOS geradores xorshift32
+// semeados por (semente, b, faixa) e intercalados (posição i do bloco vem da faixa i % XORSHIFT_FLUXOS).
+// Como cada bloco só depende da sua semente, qualquer divisão por blocos entre threads dá o mesmo vetor,
+// e as faixas independentes cabem num registrador AVX2 (8 x 32 bits).
+// A faixa é mapeada em [1..max] por multiplicação (x * max) >> 32, sem divisão. A sequência NÃO é a de
+// get_random; para reproduzir os hashes existentes use get_random_lote.
+#define XORSHIFT_FLUXOS 8
+#define XORSHIFT_BLOCO  4096
+
+// Mistura de 32 bits (finalizador do murmur3); nunca devolve 0, ponto fixo do xorshift
+static inline uint32_t xorshift_semente(uint32_t semente, uint32_t bloco, uint32_t faixa) {
+    uint32_t h = semente ^ (bloco * 0x9E3779B9u) ^ (faixa * 0x85EBCA6Bu);
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    h *= 0x846CA68Bu;
+    h ^= h >> 16;
+    return h ? h : 0x6D2B79F5u;
+}
+
+// Versão escalar: referência e fallback (produz exatamente os mesmos valores da versão AVX2)
+static inline void xorshift_bloco_escalar(uint32_t *s, uint32_t max, int *dst, size_t n) {
+    for (size_t i = 0; i < n; i += XORSHIFT_FLUXOS) {
+        for (int k = 0; k < XORSHIFT_FLUXOS; k++) {
+            uint32_t x = s[k];
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            s[k] = x;
+            if (i + (size_t)k < n)
+                dst[i + (size_t)k] = (int)(((uint64_t)x * max) >> 32) + 1;
+        }
+    }
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+
+// AVX2: 8 faixas por iteração; a multiplicação 32x32->64 é feita nas faixas pares e ímpares separadamente
+__attribute__((target("avx2")))
+static inline void xorshift_bloco_avx2(uint32_t *s, uint32_t max, int *dst, size_t n) {
+    __m256i x = _mm256_loadu_si256((const __m256i *)s);
+    const __m256i vmax = _mm256_set1_epi32((int)max);
+    const __m256i um = _mm256_set1_epi32(1);
+    size_t i = 0;
+
+    for (; i + XORSHIFT_FLUXOS <= n; i += XORSHIFT_FLUXOS) {
+        x = _mm256_xor_si256(x, _mm256_slli_epi32(x, 13));
+        x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 17));
+        x = _mm256_xor_si256(x, _mm256_slli_epi32(x, 5));
+
+        __m256i par = _mm256_srli_epi64(_mm256_mul_epu32(x, vmax), 32);
+        __m256i impar = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), vmax);
+        __m256i r = _mm256_blend_epi32(par, impar, 0xAA);
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_add_epi32(r, um));
+    }
+
+    _mm256_storeu_si256((__m256i *)s, x);
+    if (i < n)
+        xorshift_bloco_escalar(s, max, dst + i, n - i);
+}
+
+static inline int xorshift_usa_avx2(void) {
+    static int usa = -1;
+    if (usa < 0) {
+        __builtin_cpu_init();
+        usa = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return usa;
+}
+#endif
+
+// Preenche dst[0..n) com as posições [inicio, inicio + n) da sequência de fluxos; 'inicio' deve ser
+// múltiplo de XORSHIFT_BLOCO (fatias por thread alinhadas a blocos). Valores em [1..max], max > 0.
+static inline void get_random_fluxos(uint32_t semente, int max, int *dst, size_t inicio, size_t n) {
+    if (n == 0 || max <= 0)
+        return;
+
+    uint32_t s[XORSHIFT_FLUXOS];
+    size_t bloco = inicio / XORSHIFT_BLOCO;
+
+    for (size_t feito = 0; feito < n; feito += XORSHIFT_BLOCO, bloco++) {
+        size_t tam = (n - feito < XORSHIFT_BLOCO) ? n - feito : XORSHIFT_BLOCO;
+
+        for (int k = 0; k < XORSHIFT_FLUXOS; k++)
+            s[k] = xorshift_semente(semente, (uint32_t)bloco, (uint32_t)k);
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        if (xorshift_usa_avx2()) {
+            xorshift_bloco_avx2(s, (uint32_t)max, dst + feito, tam);
+            continue;
+        }
+#endif
+        xorshift_bloco_escalar(s, (uint32_t)max, dst + feito, tam);
+    }
+}
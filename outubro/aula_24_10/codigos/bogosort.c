@@ -35,10 +35,18 @@ bool is_sorted(int *v, int n) {
     return true;
 }
 
+// Sorteio usado pelo shuffle. -DSHUFFLE_LEMIRE troca por get_random_lemire (sem viés e sem divisão),
+// mas a sequência de permutações muda e a saída deixa de bater com a esperada pelo runcodes
+#ifdef SHUFFLE_LEMIRE
+#define SORTEIO_SHUFFLE get_random_lemire
+#else
+#define SORTEIO_SHUFFLE get_random
+#endif
+
 // Versão do PDF (necessária para passar no runcodes)
 void shuffle(int *v, int n, int *seed) {
     for (int i = n - 1; i >= 1; i--) {
-        int j = get_random(seed, i) - 1, temp = v[i]; 
+        int j = SORTEIO_SHUFFLE(seed, i) - 1, temp = v[i]; 
         v[i] = v[j];
         v[j] = temp;
     }
@@ -50,8 +58,7 @@ int main() {
     int *v = (int *)malloc(n * sizeof(int));
 
     // Preenche o vetor com números aleatórios entre 1 e n
-    for (int i = 0; i < n; i++) 
-        v[i] = get_random(&seed, n);
+    get_random_lote(&seed, n, v, (size_t)n);
 
     long long count = 0;
 
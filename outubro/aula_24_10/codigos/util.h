@@ -8,6 +8,10 @@
 // ---------- CRC32 ----------
 uint32_t crc32_table[256];
 
+static uint32_t crc32_slice[8][256];
+
+static int crc32_usa_clmul = 0;
+
 void init_crc32() {
     uint32_t poly = 0xEDB88320;
     for (uint32_t i = 0; i < 256; i++) {
@@ -20,13 +24,121 @@ void init_crc32() {
         }
         crc32_table[i] = c;
     }
+
+    for (int i = 0; i < 256; i++) {
+        uint32_t c = crc32_table[i];
+        crc32_slice[0][i] = c;
+        for (int k = 1; k < 8; k++) {
+            c = crc32_table[c & 0xFF] ^ (c >> 8);
+            crc32_slice[k][i] = c;
+        }
+    }
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    crc32_usa_clmul = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+#endif
+}
+
+static uint32_t crc32_slice8(uint32_t crc, const unsigned char *p, size_t size) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    while (size >= 8) {
+        uint32_t um, dois;
+        memcpy(&um, p, 4);
+        memcpy(&dois, p + 4, 4);
+        um ^= crc;
+        crc = crc32_slice[7][um & 0xFF] ^ crc32_slice[6][(um >> 8) & 0xFF] ^
+              crc32_slice[5][(um >> 16) & 0xFF] ^ crc32_slice[4][um >> 24] ^
+              crc32_slice[3][dois & 0xFF] ^ crc32_slice[2][(dois >> 8) & 0xFF] ^
+              crc32_slice[1][(dois >> 16) & 0xFF] ^ crc32_slice[0][dois >> 24];
+        p += 8;
+        size -= 8;
+    }
+#endif
+    while (size--)
+        crc = crc32_table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    return crc;
 }
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+
+__attribute__((target("pclmul,sse4.1")))
+static uint32_t crc32_clmul(uint32_t crc, const unsigned char *buf, size_t size) {
+    const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596LL, 0x0154442bd4LL);
+    const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009eLL, 0x01751997d0LL);
+    const __m128i k5k0 = _mm_set_epi64x(0, 0x0163cd6124LL);
+    const __m128i poly = _mm_set_epi64x(0x01f7011641LL, 0x01db710641LL);
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+    __m128i x1 = _mm_loadu_si128((const __m128i *)(buf + 0x00));
+    __m128i x2 = _mm_loadu_si128((const __m128i *)(buf + 0x10));
+    __m128i x3 = _mm_loadu_si128((const __m128i *)(buf + 0x20));
+    __m128i x4 = _mm_loadu_si128((const __m128i *)(buf + 0x30));
+    __m128i x5;
+
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+    buf += 64;
+    size -= 64;
+
+    while (size >= 64) {
+        __m128i l1 = _mm_clmulepi64_si128(x1, k1k2, 0x00), h1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+        __m128i l2 = _mm_clmulepi64_si128(x2, k1k2, 0x00), h2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+        __m128i l3 = _mm_clmulepi64_si128(x3, k1k2, 0x00), h3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+        __m128i l4 = _mm_clmulepi64_si128(x4, k1k2, 0x00), h4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+
+        x1 = _mm_xor_si128(_mm_xor_si128(h1, l1), _mm_loadu_si128((const __m128i *)(buf + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(h2, l2), _mm_loadu_si128((const __m128i *)(buf + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(h3, l3), _mm_loadu_si128((const __m128i *)(buf + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(h4, l4), _mm_loadu_si128((const __m128i *)(buf + 0x30)));
+
+        buf += 64;
+        size -= 64;
+    }
+
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x4), x5);
+
+    while (size >= 16) {
+        x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((const __m128i *)buf)), x5);
+        buf += 16;
+        size -= 16;
+    }
+
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k5k0, 0x00), x2);
+
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return (uint32_t)_mm_extract_epi32(x1, 1);
+}
+#endif
+
 uint32_t crc32(uint32_t crc, const void *buf, size_t size) {
     const unsigned char *p = (const unsigned char *)buf;
     crc = crc ^ ~0U;
-    while (size--)
-        crc = crc32_table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    if (crc32_usa_clmul && size >= 64) {
+        size_t bloco = size & ~(size_t)15;
+        crc = crc32_clmul(crc, p, bloco);
+        p += bloco;
+        size -= bloco;
+    }
+#endif
+    crc = crc32_slice8(crc, p, size);
     return crc ^ ~0U;
 }
 
@@ -40,3 +152,53 @@ int get_random(int *state, int max) {
     *state = x;
     return (int)((x % max) + 1);
 }
+
+// Sem viés e sem divisão no caminho comum (Lemire): parte alta de x * max, rejeitando parte baixa < 2^32 mod max
+static inline int get_random_lemire(int *state, int max) {
+    uint32_t x = (uint32_t) *state;
+    uint32_t range = (uint32_t)max;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    uint64_t m = (uint64_t)x * range;
+    uint32_t baixo = (uint32_t)m;
+
+    if (baixo < range) {
+        uint32_t limiar = (0u - range) % range;
+        while (baixo < limiar) {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            m = (uint64_t)x * range;
+            baixo = (uint32_t)m;
+        }
+    }
+
+    *state = (int)x;
+    return (int)(m >> 32) + 1;
+}
+
+// Lote: mesmo resultado (e estado final) de n chamadas a get_random(state, max), com o estado em registrador
+// e o módulo exato por multiplicação (Lemire, M = ceil(2^64 / max))
+static inline void get_random_lote(int *state, int max, int *dst, size_t n) {
+    // n = 0 (ou max <= 0): nada a sortear, e M dividiria por zero
+    if (n == 0 || max <= 0)
+        return;
+
+    uint32_t x = (uint32_t) *state;
+    uint64_t m = UINT64_C(0xFFFFFFFFFFFFFFFF) / (uint32_t)max + 1;
+
+    for (size_t i = 0; i < n; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+#ifdef __SIZEOF_INT128__
+        dst[i] = (int)((uint32_t)(((unsigned __int128)(m * x) * (uint32_t)max) >> 64) + 1);
+#else
+        dst[i] = (int)((x % (uint32_t)max) + 1);
+#endif
+    }
+
+    *state = (int)x;
+}
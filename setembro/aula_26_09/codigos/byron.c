@@ -3,36 +3,238 @@ Davi Gabriel Domingues (N° USP: 15447497)
 Pedro Martins de Oliveira (N° USP: 13696213) 
 */
 
+#ifndef _WIN32
+#define _GNU_SOURCE // pthread_setaffinity_np (fixar cada worker do --jobs num núcleo)
+#endif
 #include <ctype.h> // incluso para trim (pode ser removido se duplicado)
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h> // chaves binárias do radix sort (uint64_t)
+#include <math.h> // desvio padrão e intervalo de confiança do --repeat
 #include <time.h> // adicionado para medições de tempo (clock)
+#ifndef _WIN32
+#include <fcntl.h>    // leitura da entrada via mmap (POSIX)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <pthread.h>  // --batch --jobs N
+#include <sched.h>
+#endif
+
+/* Instrumentação opcional (Linux): compilar com -DCONTADORES_HW para que o --batch inclua comparações, trocas
+e contadores de hardware (ciclos, instruções, branch-misses, misses de L1/LLC) de cada execução.
+Tudo é por thread, então vale também com --jobs N; métodos não instrumentados saem com NA (contaComparacoes). */
+#ifdef CONTADORES_HW
+#include "../../../benchmark/contadores.h"
+_Thread_local long long contagemComparacoes = 0, contagemTrocas = 0;
+#define CONTAR_COMPARACAO() (contagemComparacoes++)
+#define CONTAR_TROCA() (contagemTrocas++)
+#else
+#define CONTAR_COMPARACAO() ((void)0)
+#define CONTAR_TROCA() ((void)0)
+#endif
 
 typedef struct { // struct utilizada para padronizar o tratamento dos dados.
 	int id;
 	double nota;
 	char cor[20];
+	int posto; // posto lexicográfico da cor (tabela de cores); ocupa o padding, sizeof continua 48
 	double comprimento;
 } Brinquedo; // ordem a ser considerada: cor, comprimento, nota, id.
 
+/* Interning das cores: durante a leitura cada cor distinta recebe um rótulo provisório (ordem de aparição)
+numa tabela hash de endereçamento aberto; ao fim da leitura as cores distintas são ordenadas com strcmp e
+cada registro troca o rótulo pelo posto lexicográfico. A partir daí, comparar cores é comparar inteiros. */
+typedef struct {
+    char (*nome)[20];  // cores distintas, na ordem de aparição
+    int *balde;        // tabela hash: rótulo + 1 (0 = vazio)
+    int distintas, capacidadeNomes, capacidadeBaldes;
+} TabelaCores;
+
+static uint32_t hashCor(const char *cor) { // FNV-1a
+    uint32_t h = 2166136261u;
+    while (*cor)
+        h = (h ^ (unsigned char)*cor++) * 16777619u;
+    return h;
+}
+
+void iniciarTabelaCores(TabelaCores *t) {
+    t->nome = NULL;
+    t->balde = NULL;
+    t->distintas = t->capacidadeNomes = t->capacidadeBaldes = 0;
+}
+
+void liberarTabelaCores(TabelaCores *t) {
+    free(t->nome);
+    free(t->balde);
+    iniciarTabelaCores(t);
+}
+
+// Devolve o rótulo provisório da cor (inserindo se for nova) ou -1 se faltar memória
+int internarCor(TabelaCores *t, const char *cor) {
+    // mantém a carga da tabela hash abaixo de 1/2
+    if (2 * (t->distintas + 1) > t->capacidadeBaldes) {
+        int capacidade = t->capacidadeBaldes ? 2 * t->capacidadeBaldes : 16;
+        int *balde = (int *)calloc(capacidade, sizeof(int));
+        if (!balde)
+            return -1;
+
+        for (int r = 0; r < t->distintas; r++) {
+            uint32_t b = hashCor(t->nome[r]) & (capacidade - 1);
+            while (balde[b])
+                b = (b + 1) & (capacidade - 1);
+            balde[b] = r + 1;
+        }
+        free(t->balde);
+        t->balde = balde;
+        t->capacidadeBaldes = capacidade;
+    }
+
+    uint32_t b = hashCor(cor) & (t->capacidadeBaldes - 1);
+    while (t->balde[b]) {
+        if (strcmp(t->nome[t->balde[b] - 1], cor) == 0)
+            return t->balde[b] - 1;
+        b = (b + 1) & (t->capacidadeBaldes - 1);
+    }
+
+    if (t->distintas == t->capacidadeNomes) {
+        int capacidade = t->capacidadeNomes ? 2 * t->capacidadeNomes : 8;
+        char (*nome)[20] = (char (*)[20])realloc(t->nome, capacidade * sizeof(*nome));
+        if (!nome)
+            return -1;
+        t->nome = nome;
+        t->capacidadeNomes = capacidade;
+    }
+
+    strncpy(t->nome[t->distintas], cor, 19);
+    t->nome[t->distintas][19] = '\0';
+    t->balde[b] = t->distintas + 1;
+    return t->distintas++;
+}
+
+static const TabelaCores *tabelaEmOrdenacao; // contexto do qsort abaixo
+
+static int compararRotulos(const void *a, const void *b) {
+    return strcmp(tabelaEmOrdenacao->nome[*(const int *)a], tabelaEmOrdenacao->nome[*(const int *)b]);
+}
+
+// Troca, em cada brinquedo, o rótulo provisório (campo posto) pelo posto lexicográfico da cor
+bool finalizarCores(const TabelaCores *t, Brinquedo *brinquedo, int n) {
+    int distintas = t->distintas > 0 ? t->distintas : 1;
+    int *rotulos = (int *)malloc(distintas * sizeof(int));
+    int *postoDoRotulo = (int *)malloc(distintas * sizeof(int));
+    if (!rotulos || !postoDoRotulo) {
+        free(rotulos);
+        free(postoDoRotulo);
+        return false;
+    }
+
+    for (int r = 0; r < t->distintas; r++)
+        rotulos[r] = r;
+    tabelaEmOrdenacao = t;
+    qsort(rotulos, t->distintas, sizeof(int), compararRotulos);
+    for (int p = 0; p < t->distintas; p++)
+        postoDoRotulo[rotulos[p]] = p;
+
+    for (int i = 0; i < n; i++)
+        brinquedo[i].posto = postoDoRotulo[brinquedo[i].posto];
+
+    free(rotulos);
+    free(postoDoRotulo);
+    return true;
+}
+
+// Atalho para vetores já montados (ex.: gerados em memória): interna todas as cores e finaliza
+bool internarCores(Brinquedo *brinquedo, int n) {
+    TabelaCores t;
+    iniciarTabelaCores(&t);
+    for (int i = 0; i < n; i++) {
+        brinquedo[i].posto = internarCor(&t, brinquedo[i].cor);
+        if (brinquedo[i].posto < 0) {
+            liberarTabelaCores(&t);
+            return false;
+        }
+    }
+
+    bool ok = finalizarCores(&t, brinquedo, n);
+    liberarTabelaCores(&t);
+    return ok;
+}
+
+/* Depuração opcional: compilar com -DDEPURAR_POSTOS para conferir a pré-condição dos motores (posto vindo de
+internarCores/finalizarCores). compararBrinquedos confere cada par (mesma ordem por posto e por strcmp das cores)
+e os motores por chave (radix, índices, SoA), que não passam por ele, conferem o vetor inteiro na entrada.
+Falhando, aborta com a mensagem em vez de ordenar em silêncio por lixo. */
+#ifdef DEPURAR_POSTOS
+static void postosInconsistentes(const char *quem) {
+    fprintf(stderr, "%s: posto de cor inconsistente com a cor (faltou internarCores?).\n", quem);
+    abort();
+}
+
+static void conferirPostos(const Brinquedo *brinquedo, int n, const char *quem) {
+    // postos válidos ficam em [0, cores distintas) e cores distintas <= n
+    const char **corDoPosto = (const char **)calloc(n > 0 ? n : 1, sizeof(const char *));
+    if (!corDoPosto)
+        return;
+
+    bool ok = true;
+    for (int i = 0; ok && i < n; i++) {
+        int p = brinquedo[i].posto;
+        if (p < 0 || p >= n)
+            ok = false;
+        else if (!corDoPosto[p])
+            corDoPosto[p] = brinquedo[i].cor;
+        else
+            ok = strcmp(corDoPosto[p], brinquedo[i].cor) == 0;
+    }
+    const char *anterior = NULL;
+    for (int p = 0; ok && p < n; p++) {
+        if (!corDoPosto[p])
+            continue;
+        ok = !anterior || strcmp(anterior, corDoPosto[p]) < 0;
+        anterior = corDoPosto[p];
+    }
+    free(corDoPosto);
+    if (!ok)
+        postosInconsistentes(quem);
+}
+
+#define CONFERIR_POSTOS(brinquedo, n) conferirPostos((brinquedo), (n), __func__)
+#define CONFERIR_PAR(a, b) \
+    do { \
+        int c = strcmp((a)->cor, (b)->cor); \
+        if ((c < 0) != ((a)->posto < (b)->posto) || (c == 0) != ((a)->posto == (b)->posto)) \
+            postosInconsistentes(__func__); \
+    } while (0)
+#else
+#define CONFERIR_POSTOS(brinquedo, n) ((void)0)
+#define CONFERIR_PAR(a, b) ((void)0)
+#endif
+
 // funções auxiliares
 void capitaoGinyu (Brinquedo *x, Brinquedo *y) { /* referência de Dragon Ball Z: "trocaaaaaar!", ou seja, realiza a troca
 de variáveis no vetor, via uso de variáveis temporárias. */
+    CONTAR_TROCA();
     Brinquedo temporario = *x;
     *x = *y;
     *y = temporario;
 }
 
+/* Pré-condição: o campo posto dos dois brinquedos veio de internarCores (ou da leitura, que chama finalizarCores)
+sobre o mesmo vetor. A cor em si não é consultada, então um vetor montado à mão sem internarCores é ordenado
+pelo lixo (ou pelos zeros) em posto, sem erro; -DDEPURAR_POSTOS confere isso a cada comparação. */
 int compararBrinquedos(const Brinquedo *brinquedo1, const Brinquedo *brinquedo2) { /* a função vai forçar a estabilidade
 em todos os métodos de ordenação. */
 /* retorna valor maior que 0, caso o brinquedo1 deva estar à frente do brinquedo2, mas retorna valor menor que zero,
 caso contrário */
-    int x = strcmp(brinquedo1->cor, brinquedo2->cor); /* função de "string.h" para analisar se os nomes são iguais (0 = iguais,
-    1 = primeira string maior, -1 = segunda string maior). Usa-se o critério de comparação lexicográfica para esse tamanho. */
-    if (x != 0)
-        return x;
+    CONTAR_COMPARACAO();
+    CONFERIR_PAR(brinquedo1, brinquedo2);
+    /* cor: os postos vêm da tabela de cores (interning), então a ordem lexicográfica das strings
+    vira comparação de inteiros, sem strcmp por comparação. */
+    if (brinquedo1->posto != brinquedo2->posto)
+        return brinquedo1->posto < brinquedo2->posto ? -1 : 1;
         
     if (brinquedo1->comprimento > brinquedo2->comprimento)
         return 1;
@@ -125,79 +327,86 @@ de seu desempenho amortizado, comparado à inserção direta tradicional */
     }
 }
 
-void junta(Brinquedo *brinquedos, int inicio, int meio, int fim) {
-    int i, j, k;
-    int n1 = meio - inicio + 1;
-    int n2 = fim - meio;
+#define MERGE_CORTE_INSERCAO 16 // corridas iniciais ordenadas por inserção antes das intercalações
 
-    // Usar heap em vez de VLA para evitar estouro de pilha em entradas grandes
-    Brinquedo *leftArr = NULL;
-    Brinquedo *rightArr = NULL;
+// Intercala src[inicio..meio) e src[meio..fim) em dst[inicio..fim), estável (empate fica com a esquerda)
+void junta(const Brinquedo *src, Brinquedo *dst, int inicio, int meio, int fim) {
+    int i = inicio, j = meio, k = inicio;
 
-    if (n1 > 0) {
-        leftArr = (Brinquedo*)malloc(n1 * sizeof(Brinquedo));
-        if (!leftArr)
-            return; // falha em alocar -> evita comportamento indefinido
+    while (i < meio && j < fim) {
+        if (compararBrinquedos(&src[i], &src[j]) <= 0)
+            dst[k++] = src[i++];
+        else
+            dst[k++] = src[j++];
     }
-    
-    if (n2 > 0) {
-        rightArr = (Brinquedo*)malloc(n2 * sizeof(Brinquedo));
 
-        if (!rightArr) { 
-            free(leftArr); 
-            return; 
+    memcpy(&dst[k], &src[i], (meio - i) * sizeof(Brinquedo));
+    k += meio - i;
+    memcpy(&dst[k], &src[j], (fim - j) * sizeof(Brinquedo));
+}
+
+/* Merge sort bottom-up sem alocação: 'arena' (n registros, do chamador) e o próprio vetor se alternam como
+origem/destino a cada passe, como no algoritmo_id2_mergesort de tiroNoEscuro_otimizado.c. Corridas de
+MERGE_CORTE_INSERCAO são ordenadas por inserção; pares já em ordem (esquerda[último] <= direita[primeiro])
+são só copiados, e um passe em que todas as fronteiras já estão em ordem encerra a ordenação. */
+void ordenacaoViaMergeSortArena(Brinquedo *brinquedos, int n, Brinquedo *arena) {
+    if (n <= 1)
+        return;
+
+    for (int inicio = 0; inicio < n; inicio += MERGE_CORTE_INSERCAO) {
+        int fim = inicio + MERGE_CORTE_INSERCAO < n ? inicio + MERGE_CORTE_INSERCAO : n;
+        for (int i = inicio + 1; i < fim; i++) {
+            Brinquedo chave = brinquedos[i];
+            int j = i - 1;
+            while (j >= inicio && compararBrinquedos(&brinquedos[j], &chave) > 0) {
+                brinquedos[j + 1] = brinquedos[j];
+                j--;
+            }
+            brinquedos[j + 1] = chave;
         }
     }
 
-    for (i = 0; i < n1; i++)
-        leftArr[i] = brinquedos[inicio + i];
-
-    for (j = 0; j < n2; j++)
-        rightArr[j] = brinquedos[meio + 1 + j];
+    Brinquedo *src = brinquedos, *dst = arena;
+    for (int largura = MERGE_CORTE_INSERCAO; largura < n; largura *= 2) {
+        bool jaOrdenado = true; // todas as fronteiras entre corridas, não só as dos pares deste passe
+        for (int inicio = largura; inicio < n; inicio += largura)
+            if (compararBrinquedos(&src[inicio - 1], &src[inicio]) > 0) {
+                jaOrdenado = false;
+                break;
+            }
+        if (jaOrdenado)
+            break;
 
-    i = 0;
-    j = 0;
-    k = inicio;
+        for (int inicio = 0; inicio < n; inicio += 2 * largura) {
+            int meio = inicio + largura < n ? inicio + largura : n;
+            int fim = inicio + 2 * largura < n ? inicio + 2 * largura : n;
 
-    while (i < n1 && j < n2) {
-        if (compararBrinquedos(&leftArr[i], &rightArr[j]) <= 0) {
-            brinquedos[k] = leftArr[i];
-            i++;
-        }
-        else {
-            brinquedos[k] = rightArr[j];
-            j++;
+            if (meio >= fim || compararBrinquedos(&src[meio - 1], &src[meio]) <= 0)
+                memcpy(&dst[inicio], &src[inicio], (fim - inicio) * sizeof(Brinquedo));
+            else
+                junta(src, dst, inicio, meio, fim);
         }
-        k++;
-    }
-
-    while (i < n1) {
-        brinquedos[k] = leftArr[i];
-        i++;
-        k++;
-    }
 
-    while (j < n2) {
-        brinquedos[k] = rightArr[j];
-        j++;
-        k++;
+        Brinquedo *t = src;
+        src = dst;
+        dst = t;
     }
 
-    free(leftArr);
-    free(rightArr);
+    if (src != brinquedos)
+        memcpy(brinquedos, src, n * sizeof(Brinquedo));
 }
 
+// Interface original (intervalo fechado [inicio, fim]): uma única arena para a ordenação inteira
 void ordenacaoViaMergeSort(Brinquedo *brinquedos, int inicio, int fim) {
-    if(inicio >= fim) return; // Condição de saída
-
-    int meio = inicio + (fim - inicio)/2;
+    if (inicio >= fim) return; // Condição de saída
 
-    ordenacaoViaMergeSort(brinquedos, inicio, meio);
-    ordenacaoViaMergeSort(brinquedos, meio + 1, fim);
+    int n = fim - inicio + 1;
+    Brinquedo *arena = (Brinquedo *)malloc(n * sizeof(Brinquedo));
+    if (!arena)
+        return; // falha em alocar -> evita comportamento indefinido
 
-    junta(brinquedos, inicio, meio, fim);
-
-    return;
+    ordenacaoViaMergeSortArena(brinquedos + inicio, n, arena);
+    free(arena);
 }
 
 int particiona(Brinquedo *brinquedo, int inicio, int fim) {
@@ -235,144 +444,2530 @@ void ordenacaoViaQuickSort(Brinquedo *brinquedo, int inicio, int fim) {
     }
 }
 
-// Copia n elementos de src para dst
-void copiarVetor(Brinquedo *dst, const Brinquedo *src, int n) {
-    if (n <= 0) return;
-    memcpy(dst, src, n * sizeof(Brinquedo));
+/* Radix sort LSD estável sobre chaves binárias que preservam a ordem de compararBrinquedos:
+- cor vira o seu posto lexicográfico da tabela de cores (7 no inputGenerator.py -> 3 bits úteis);
+- doubles viram inteiros sem sinal com a mesma ordem (positivos: liga o bit de sinal; negativos: inverte tudo);
+- nota é decrescente, então usa-se o complemento da chave; id entra como último critério.
+Os itens (chave + índice) são ordenados em base 256, um dígito por passe, e só no fim os registros são
+permutados. Passes cujo dígito é igual em todos os itens (ex.: bytes altos do id) são pulados. */
+#define RADIX_DIGITOS 24 // 4 (id) + 8 (nota) + 8 (comprimento) + 4 (cor), do menos para o mais significativo
+
+typedef struct {
+    unsigned char digito[RADIX_DIGITOS]; // chave já quebrada em bytes: digito[d] é o d-ésimo passe
+    uint32_t indice;                     // posição do registro no vetor de entrada
+} ChaveBrinquedo;
+
+static uint64_t chaveDouble(double d) {
+    uint64_t u;
+    if (d == 0.0)
+        d = 0.0; // -0.0 e 0.0 são iguais para a comparação
+    memcpy(&u, &d, sizeof(u));
+    return (u & UINT64_C(0x8000000000000000)) ? ~u : (u | UINT64_C(0x8000000000000000));
 }
 
-// Executa um algoritmo sobre uma cópia dos dados originais, retorna tempo em segundos
-void executarAlgoritmoCopia(const Brinquedo *orig, int n, int metodo, double *tempo_out) {
-    Brinquedo *tmp = (Brinquedo*)malloc(n * sizeof(Brinquedo));
-    if (!tmp) {
-        *tempo_out = -1.0;
+static void montarChave(ChaveBrinquedo *c, const Brinquedo *b, uint32_t postoCor, uint32_t indice) {
+    uint32_t id = (uint32_t)b->id ^ 0x80000000u; // ids negativos antes dos positivos
+    uint64_t nota = ~chaveDouble(b->nota);       // maior nota primeiro
+    uint64_t comprimento = chaveDouble(b->comprimento);
+
+    for (int k = 0; k < 4; k++) {
+        c->digito[k] = (unsigned char)(id >> (8 * k));
+        c->digito[20 + k] = (unsigned char)(postoCor >> (8 * k));
+    }
+    for (int k = 0; k < 8; k++) {
+        c->digito[4 + k] = (unsigned char)(nota >> (8 * k));
+        c->digito[12 + k] = (unsigned char)(comprimento >> (8 * k));
+    }
+    c->indice = indice;
+}
+
+void ordenacaoViaRadixSort(Brinquedo *brinquedo, int numeroBrinquedos) {
+    int n = numeroBrinquedos;
+    if (n <= 1 || brinquedo == NULL)
         return;
+    CONFERIR_POSTOS(brinquedo, n);
+
+    ChaveBrinquedo *chaves = (ChaveBrinquedo *)malloc(n * sizeof(ChaveBrinquedo));
+    ChaveBrinquedo *aux = (ChaveBrinquedo *)malloc(n * sizeof(ChaveBrinquedo));
+    if (!chaves || !aux) {
+        free(chaves);
+        free(aux);
+        return; // falha em alocar -> mantém o vetor como está
     }
-    copiarVetor(tmp, orig, n);
-    clock_t start = clock();
-    switch (metodo) {
-        case 1: ordenacaoViaBubbleSort(tmp, n); break;
-        case 2: ordenacaoViaInsertionSort(tmp, n); break;
-        case 3: ordenacaoViaMergeSort(tmp, 0, n - 1); break;
-        case 4: ordenacaoViaQuickSort(tmp, 0, n - 1); break;
-        default: break;
+
+    for (int i = 0; i < n; i++)
+        montarChave(&chaves[i], &brinquedo[i], (uint32_t)brinquedo[i].posto, (uint32_t)i);
+
+    // um único passe conta os histogramas de todos os dígitos
+    uint32_t contagem[RADIX_DIGITOS][256] = {{0}}; // local (24 KB de pilha): reentrante entre threads
+    for (int i = 0; i < n; i++)
+        for (int d = 0; d < RADIX_DIGITOS; d++)
+            contagem[d][chaves[i].digito[d]]++;
+
+    ChaveBrinquedo *src = chaves, *dst = aux;
+    for (int d = 0; d < RADIX_DIGITOS; d++) {
+        // dígito constante: a distribuição seria a identidade
+        if (contagem[d][src[0].digito[d]] == (uint32_t)n)
+            continue;
+
+        uint32_t soma = 0;
+        for (int b = 0; b < 256; b++) {
+            uint32_t c = contagem[d][b];
+            contagem[d][b] = soma;
+            soma += c;
+        }
+
+        for (int i = 0; i < n; i++)
+            dst[contagem[d][src[i].digito[d]]++] = src[i];
+
+        ChaveBrinquedo *t = src;
+        src = dst;
+        dst = t;
     }
-    clock_t end = clock();
-    *tempo_out = (double)(end - start) / (double)CLOCKS_PER_SEC;
-    free(tmp);
+
+    // permutação final dos registros: um gather para um vetor novo e cópia de volta
+    Brinquedo *ordenados = (Brinquedo *)malloc(n * sizeof(Brinquedo));
+    if (ordenados) {
+        for (int i = 0; i < n; i++)
+            ordenados[i] = brinquedo[src[i].indice];
+        memcpy(brinquedo, ordenados, n * sizeof(Brinquedo));
+        free(ordenados);
+    }
+
+    free(chaves);
+    free(aux);
 }
 
-// substitui a main original para suportar --batch sem quebrar o uso original
-int main(int argc, char *argv[]) {
-    // Modo batch: --batch <lista.txt> [all|1,2,3,4]
-    if (argc >= 3 && strcmp(argv[1], "--batch") == 0) {
-        const char *listaPath = argv[2];
-        const char *algosSpec = (argc >= 4) ? argv[3] : "all";
-        FILE *lf = fopen(listaPath, "r");
-        if (!lf) {
-            fprintf(stderr, "Erro ao abrir lista de testes: %s\n", listaPath);
-            return -1;
+/* Ordenação por indireção: em vez de mover structs de 48 bytes, ordena pares (chave compactada, índice)
+de 24 bytes. A chave usa as mesmas codificações do radix (posto da cor, doubles com bits invertidos, nota
+complementada), então a comparação vira três comparações de inteiros; empate completo (raro) decide pelo índice,
+que segue a ordem de leitura (a do id) sem voltar aos registros de 48 bytes.
+Merge sort bottom-up estável com um único buffer auxiliar; o resultado é a ordem dos índices, e quem chama
+decide se só lê os ids (saída do runcodes) ou permuta os registros de uma vez. */
+typedef struct {
+    uint64_t comprimento; // chaveDouble(comprimento)
+    uint64_t nota;        // ~chaveDouble(nota)
+    uint32_t cor;         // posto lexicográfico da cor
+    uint32_t indice;
+} ParChaveIndice;
+
+static inline bool parMenorOuIgual(const ParChaveIndice *a, const ParChaveIndice *b) {
+    if (a->cor != b->cor)
+        return a->cor < b->cor;
+    if (a->comprimento != b->comprimento)
+        return a->comprimento < b->comprimento;
+    if (a->nota != b->nota)
+        return a->nota < b->nota;
+    return a->indice <= b->indice;
+}
+
+// Preenche ordem[0..n) com os índices dos brinquedos na ordem final; devolve false se faltar memória
+bool ordenarIndices(const Brinquedo *brinquedo, int n, uint32_t *ordem) {
+    if (n <= 0)
+        return true;
+    CONFERIR_POSTOS(brinquedo, n);
+
+    ParChaveIndice *pares = (ParChaveIndice *)malloc(n * sizeof(ParChaveIndice));
+    ParChaveIndice *aux = (ParChaveIndice *)malloc(n * sizeof(ParChaveIndice));
+    if (!pares || !aux) {
+        free(pares);
+        free(aux);
+        return false;
+    }
+
+    for (int i = 0; i < n; i++) {
+        pares[i].comprimento = chaveDouble(brinquedo[i].comprimento);
+        pares[i].nota = ~chaveDouble(brinquedo[i].nota);
+        pares[i].cor = (uint32_t)brinquedo[i].posto;
+        pares[i].indice = (uint32_t)i;
+    }
+
+    // passes de largura 1, 2, 4, ... alternando entre os dois vetores
+    ParChaveIndice *src = pares, *dst = aux;
+    for (int largura = 1; largura < n; largura *= 2) {
+        for (int inicio = 0; inicio < n; inicio += 2 * largura) {
+            int meio = inicio + largura < n ? inicio + largura : n;
+            int fim = inicio + 2 * largura < n ? inicio + 2 * largura : n;
+            int i = inicio, j = meio, k = inicio;
+
+            // metades já em ordem: cópia direta
+            if (meio == fim || parMenorOuIgual(&src[meio - 1], &src[meio])) {
+                memcpy(&dst[inicio], &src[inicio], (fim - inicio) * sizeof(ParChaveIndice));
+                continue;
+            }
+
+            while (i < meio && j < fim) {
+                if (parMenorOuIgual(&src[i], &src[j]))
+                    dst[k++] = src[i++];
+                else
+                    dst[k++] = src[j++];
+            }
+            while (i < meio)
+                dst[k++] = src[i++];
+            while (j < fim)
+                dst[k++] = src[j++];
         }
 
-        // preparar lista de algoritmos a executar
-        bool runAlgo[5] = { false, true, true, true, true }; // index 1..4 (default all)
-        if (strcmp(algosSpec, "all") != 0) {
-            // reset e parse simples "1,2" ou "2"
-            for (int i = 0; i <= 4; i++) runAlgo[i] = false;
-            char specbuf[128];
-            strncpy(specbuf, algosSpec, sizeof(specbuf)-1);
-            specbuf[sizeof(specbuf)-1] = '\0';
-            char *tok = strtok(specbuf, ",");
-            while (tok) {
-                int a = atoi(tok);
-                if (a >= 1 && a <= 4) runAlgo[a] = true;
-                tok = strtok(NULL, ",");
+        ParChaveIndice *t = src;
+        src = dst;
+        dst = t;
+    }
+
+    for (int i = 0; i < n; i++)
+        ordem[i] = src[i].indice;
+
+    free(pares);
+    free(aux);
+    return true;
+}
+
+// Versão "in-place" para o --batch e o benchmark: ordena os índices e permuta os registros num único gather
+void ordenacaoViaIndices(Brinquedo *brinquedo, int numeroBrinquedos) {
+    int n = numeroBrinquedos;
+    if (n <= 1 || brinquedo == NULL)
+        return;
+
+    uint32_t *ordem = (uint32_t *)malloc(n * sizeof(uint32_t));
+    Brinquedo *ordenados = (Brinquedo *)malloc(n * sizeof(Brinquedo));
+    if (ordem && ordenados && ordenarIndices(brinquedo, n, ordem)) {
+        for (int i = 0; i < n; i++)
+            ordenados[i] = brinquedo[ordem[i]];
+        memcpy(brinquedo, ordenados, n * sizeof(Brinquedo));
+    }
+
+    free(ordem);
+    free(ordenados);
+}
+
+/* Layout opcional em estrutura de arrays (SoA): id, posto, comprimento e nota em vetores separados.
+A comparação lê só 24 bytes espalhados em quatro vetores contíguos e cada movimento copia 24 bytes em vez
+de 48 (o nome da cor fica de fora: o posto basta). Merge sort bottom-up estável com um conjunto auxiliar
+de vetores, alternando origem e destino a cada passe. */
+typedef struct {
+    int *id;
+    int *posto;
+    double *comprimento;
+    double *nota;
+} BrinquedosSoA;
+
+void liberarSoA(BrinquedosSoA *soa) {
+    free(soa->id);
+    free(soa->posto);
+    free(soa->comprimento);
+    free(soa->nota);
+    soa->id = soa->posto = NULL;
+    soa->comprimento = soa->nota = NULL;
+}
+
+bool alocarSoA(BrinquedosSoA *soa, int n) {
+    size_t tam = n > 0 ? (size_t)n : 1;
+    soa->id = (int *)malloc(tam * sizeof(int));
+    soa->posto = (int *)malloc(tam * sizeof(int));
+    soa->comprimento = (double *)malloc(tam * sizeof(double));
+    soa->nota = (double *)malloc(tam * sizeof(double));
+    if (!soa->id || !soa->posto || !soa->comprimento || !soa->nota) {
+        liberarSoA(soa);
+        return false;
+    }
+    return true;
+}
+
+// Mesma ordem de compararBrinquedos: a (de x) vem antes ou empata com b (de y)
+static inline bool soaMenorOuIgual(const BrinquedosSoA *x, int a, const BrinquedosSoA *y, int b) {
+    if (x->posto[a] != y->posto[b])
+        return x->posto[a] < y->posto[b];
+    if (x->comprimento[a] != y->comprimento[b])
+        return x->comprimento[a] < y->comprimento[b];
+    if (x->nota[a] != y->nota[b])
+        return x->nota[a] > y->nota[b];
+    return x->id[a] <= y->id[b];
+}
+
+static inline void soaCopiar(BrinquedosSoA *dst, int k, const BrinquedosSoA *src, int i) {
+    dst->id[k] = src->id[i];
+    dst->posto[k] = src->posto[i];
+    dst->comprimento[k] = src->comprimento[i];
+    dst->nota[k] = src->nota[i];
+}
+
+// Ordena soa[0..n); devolve false (sem alterar nada) se faltar memória para o auxiliar
+bool ordenacaoViaMergeSortSoA(BrinquedosSoA *soa, int n) {
+    BrinquedosSoA aux;
+    if (n <= 1)
+        return true;
+    if (!alocarSoA(&aux, n))
+        return false;
+
+    BrinquedosSoA vetores[2] = { *soa, aux };
+    int origem = 0;
+    for (int largura = 1; largura < n; largura *= 2) {
+        BrinquedosSoA *src = &vetores[origem], *dst = &vetores[1 - origem];
+
+        for (int inicio = 0; inicio < n; inicio += 2 * largura) {
+            int meio = inicio + largura < n ? inicio + largura : n;
+            int fim = inicio + 2 * largura < n ? inicio + 2 * largura : n;
+            int i = inicio, j = meio, k = inicio;
+
+            if (meio < fim && !soaMenorOuIgual(src, meio - 1, src, meio)) {
+                while (i < meio && j < fim) {
+                    if (soaMenorOuIgual(src, i, src, j))
+                        soaCopiar(dst, k++, src, i++);
+                    else
+                        soaCopiar(dst, k++, src, j++);
+                }
             }
+
+            // restos (ou o bloco inteiro, se as metades já estavam em ordem)
+            size_t resto = (size_t)(meio - i);
+            memcpy(&dst->id[k], &src->id[i], resto * sizeof(int));
+            memcpy(&dst->posto[k], &src->posto[i], resto * sizeof(int));
+            memcpy(&dst->comprimento[k], &src->comprimento[i], resto * sizeof(double));
+            memcpy(&dst->nota[k], &src->nota[i], resto * sizeof(double));
+            k += meio - i;
+
+            resto = (size_t)(fim - j);
+            memcpy(&dst->id[k], &src->id[j], resto * sizeof(int));
+            memcpy(&dst->posto[k], &src->posto[j], resto * sizeof(int));
+            memcpy(&dst->comprimento[k], &src->comprimento[j], resto * sizeof(double));
+            memcpy(&dst->nota[k], &src->nota[j], resto * sizeof(double));
         }
+        origem = 1 - origem;
+    }
+
+    // o resultado pode ter terminado no auxiliar: basta trocar os ponteiros
+    if (origem == 1) {
+        aux = *soa;
+        *soa = vetores[1];
+    }
+    liberarSoA(&aux);
+    return true;
+}
 
-        char pathbuf[1024];
-        while (fgets(pathbuf, sizeof(pathbuf), lf)) {
-            // trim newline/carriage
-            size_t L = strlen(pathbuf);
-            while (L > 0 && (pathbuf[L-1] == '\n' || pathbuf[L-1] == '\r')) { pathbuf[--L] = '\0'; }
-            if (L == 0) continue;
+// Engine com a mesma assinatura das demais: converte para SoA, ordena e reescreve os registros. O nome da
+// cor volta pelo posto (bijeção com as cores distintas), então o SoA não precisa carregar a string.
+void ordenacaoViaSoA(Brinquedo *brinquedo, int numeroBrinquedos) {
+    int n = numeroBrinquedos, distintas = 0;
+    BrinquedosSoA soa;
+    if (n <= 1 || brinquedo == NULL || !alocarSoA(&soa, n))
+        return;
+    CONFERIR_POSTOS(brinquedo, n);
 
-            FILE *tf = fopen(pathbuf, "r");
-            if (!tf) {
-                fprintf(stderr, "Falha ao abrir arquivo de teste: %s\n", pathbuf);
-                continue;
+    for (int i = 0; i < n; i++) {
+        soa.id[i] = brinquedo[i].id;
+        soa.posto[i] = brinquedo[i].posto;
+        soa.comprimento[i] = brinquedo[i].comprimento;
+        soa.nota[i] = brinquedo[i].nota;
+        if (brinquedo[i].posto >= distintas)
+            distintas = brinquedo[i].posto + 1;
+    }
+
+    char (*nomePorPosto)[20] = (char (*)[20])malloc(distintas * sizeof(*nomePorPosto));
+    if (nomePorPosto && ordenacaoViaMergeSortSoA(&soa, n)) {
+        for (int i = 0; i < n; i++)
+            memcpy(nomePorPosto[brinquedo[i].posto], brinquedo[i].cor, sizeof(brinquedo[i].cor));
+
+        for (int i = 0; i < n; i++) {
+            brinquedo[i].id = soa.id[i];
+            brinquedo[i].posto = soa.posto[i];
+            brinquedo[i].comprimento = soa.comprimento[i];
+            brinquedo[i].nota = soa.nota[i];
+            memcpy(brinquedo[i].cor, nomePorPosto[soa.posto[i]], sizeof(brinquedo[i].cor));
+        }
+    }
+
+    free(nomePorPosto);
+    liberarSoA(&soa);
+}
+
+/* Timsort para Brinquedo: detecta corridas naturais (as estritamente decrescentes são invertidas, o que mantém
+a estabilidade), estende as curtas até minRun com inserção binária e intercala as corridas de uma pilha que
+respeita os invariantes de tamanho do Timsort. As intercalações "galopam" (busca exponencial) quando uma das
+corridas vence muitas comparações seguidas. Um único buffer de n/2 + 1 registros é alocado no início.
+best.in já é uma corrida só e worst.in é uma corrida estritamente decrescente: ambos saem em O(n). */
+#define TIM_MIN_MERGE 32
+#define TIM_MIN_GALLOP 7
+#define TIM_PILHA 85
+
+typedef struct {
+    Brinquedo *a;
+    Brinquedo *tmp;
+    int minGallop;
+    int topo;
+    int base[TIM_PILHA], tamanho[TIM_PILHA];
+} EstadoTimsort;
+
+static int timMinRun(int n) {
+    int r = 0;
+    while (n >= TIM_MIN_MERGE) {
+        r |= n & 1;
+        n >>= 1;
+    }
+    return n + r;
+}
+
+// Insere a[inicio..fim) em a[lo..inicio), já ordenado, por busca binária (estável: depois dos iguais)
+static void timInsercaoBinaria(Brinquedo *a, int lo, int fim, int inicio) {
+    for (; inicio < fim; inicio++) {
+        Brinquedo pivo = a[inicio];
+        int esq = lo, dir = inicio;
+        while (esq < dir) {
+            int meio = (esq + dir) >> 1;
+            if (compararBrinquedos(&pivo, &a[meio]) < 0)
+                dir = meio;
+            else
+                esq = meio + 1;
+        }
+        memmove(&a[esq + 1], &a[esq], (inicio - esq) * sizeof(Brinquedo));
+        a[esq] = pivo;
+    }
+}
+
+// Tamanho da corrida que começa em lo; se for estritamente decrescente, é invertida no lugar
+static int timContarCorrida(Brinquedo *a, int lo, int hi) {
+    int fim = lo + 1;
+    if (fim == hi)
+        return 1;
+
+    if (compararBrinquedos(&a[fim++], &a[lo]) < 0) {
+        while (fim < hi && compararBrinquedos(&a[fim], &a[fim - 1]) < 0)
+            fim++;
+        for (int i = lo, j = fim - 1; i < j; i++, j--)
+            capitaoGinyu(&a[i], &a[j]);
+    }
+    else {
+        while (fim < hi && compararBrinquedos(&a[fim], &a[fim - 1]) >= 0)
+            fim++;
+    }
+    return fim - lo;
+}
+
+// Posição k em v[0..n) com v[k-1] < chave <= v[k] (antes dos iguais), partindo de 'dica'
+static int timGalopeEsquerda(const Brinquedo *chave, const Brinquedo *v, int n, int dica) {
+    int ultimo = 0, ofs = 1;
+    if (compararBrinquedos(chave, &v[dica]) > 0) {
+        int maxOfs = n - dica;
+        while (ofs < maxOfs && compararBrinquedos(chave, &v[dica + ofs]) > 0) {
+            ultimo = ofs;
+            ofs = (ofs << 1) + 1;
+            if (ofs <= 0)
+                ofs = maxOfs;
+        }
+        if (ofs > maxOfs)
+            ofs = maxOfs;
+        ultimo += dica;
+        ofs += dica;
+    }
+    else {
+        int maxOfs = dica + 1;
+        while (ofs < maxOfs && compararBrinquedos(chave, &v[dica - ofs]) <= 0) {
+            ultimo = ofs;
+            ofs = (ofs << 1) + 1;
+            if (ofs <= 0)
+                ofs = maxOfs;
+        }
+        if (ofs > maxOfs)
+            ofs = maxOfs;
+        int t = ultimo;
+        ultimo = dica - ofs;
+        ofs = dica - t;
+    }
+
+    // busca binária em (ultimo, ofs]
+    ultimo++;
+    while (ultimo < ofs) {
+        int m = ultimo + ((ofs - ultimo) >> 1);
+        if (compararBrinquedos(chave, &v[m]) > 0)
+            ultimo = m + 1;
+        else
+            ofs = m;
+    }
+    return ofs;
+}
+
+// Posição k em v[0..n) com v[k-1] <= chave < v[k] (depois dos iguais), partindo de 'dica'
+static int timGalopeDireita(const Brinquedo *chave, const Brinquedo *v, int n, int dica) {
+    int ultimo = 0, ofs = 1;
+    if (compararBrinquedos(chave, &v[dica]) < 0) {
+        int maxOfs = dica + 1;
+        while (ofs < maxOfs && compararBrinquedos(chave, &v[dica - ofs]) < 0) {
+            ultimo = ofs;
+            ofs = (ofs << 1) + 1;
+            if (ofs <= 0)
+                ofs = maxOfs;
+        }
+        if (ofs > maxOfs)
+            ofs = maxOfs;
+        int t = ultimo;
+        ultimo = dica - ofs;
+        ofs = dica - t;
+    }
+    else {
+        int maxOfs = n - dica;
+        while (ofs < maxOfs && compararBrinquedos(chave, &v[dica + ofs]) >= 0) {
+            ultimo = ofs;
+            ofs = (ofs << 1) + 1;
+            if (ofs <= 0)
+                ofs = maxOfs;
+        }
+        if (ofs > maxOfs)
+            ofs = maxOfs;
+        ultimo += dica;
+        ofs += dica;
+    }
+
+    ultimo++;
+    while (ultimo < ofs) {
+        int m = ultimo + ((ofs - ultimo) >> 1);
+        if (compararBrinquedos(chave, &v[m]) < 0)
+            ofs = m;
+        else
+            ultimo = m + 1;
+    }
+    return ofs;
+}
+
+// Intercala corridas adjacentes com len1 <= len2: a primeira vai para o buffer e o resultado é escrito da esquerda
+static void timIntercalarBaixo(EstadoTimsort *st, int base1, int len1, int base2, int len2) {
+    Brinquedo *a = st->a, *tmp = st->tmp;
+    memcpy(tmp, &a[base1], len1 * sizeof(Brinquedo));
+    int c1 = 0, c2 = base2, dest = base1;
+    int minGallop = st->minGallop;
+
+    a[dest++] = a[c2++];
+    if (--len2 == 0) {
+        memcpy(&a[dest], &tmp[c1], len1 * sizeof(Brinquedo));
+        return;
+    }
+    if (len1 == 1) {
+        memmove(&a[dest], &a[c2], len2 * sizeof(Brinquedo));
+        a[dest + len2] = tmp[c1];
+        return;
+    }
+
+    for (;;) {
+        int vitorias1 = 0, vitorias2 = 0;
+
+        // modo normal: um a um, até uma corrida vencer minGallop vezes seguidas
+        do {
+            if (compararBrinquedos(&a[c2], &tmp[c1]) < 0) {
+                a[dest++] = a[c2++];
+                vitorias2++;
+                vitorias1 = 0;
+                if (--len2 == 0)
+                    goto fim;
             }
+            else {
+                a[dest++] = tmp[c1++];
+                vitorias1++;
+                vitorias2 = 0;
+                if (--len1 == 1)
+                    goto fim;
+            }
+        } while ((vitorias1 | vitorias2) < minGallop);
 
-            int numeroBrinquedos = 0;
-            if (fscanf(tf, "%d", &numeroBrinquedos) != 1) {
-                fprintf(stderr, "Formato inválido (numeroBrinquedos) em: %s\n", pathbuf);
-                fclose(tf);
-                continue;
+        // modo galope: copia blocos inteiros enquanto compensar
+        do {
+            vitorias1 = timGalopeDireita(&a[c2], &tmp[c1], len1, 0);
+            if (vitorias1 != 0) {
+                memcpy(&a[dest], &tmp[c1], vitorias1 * sizeof(Brinquedo));
+                dest += vitorias1;
+                c1 += vitorias1;
+                len1 -= vitorias1;
+                if (len1 <= 1)
+                    goto fim;
             }
+            a[dest++] = a[c2++];
+            if (--len2 == 0)
+                goto fim;
 
-            Brinquedo *orig = (Brinquedo*)malloc(numeroBrinquedos * sizeof(Brinquedo));
-            if (!orig) {
-                fprintf(stderr, "Falha alocar vetor para: %s\n", pathbuf);
-                fclose(tf);
-                continue;
+            vitorias2 = timGalopeEsquerda(&tmp[c1], &a[c2], len2, 0);
+            if (vitorias2 != 0) {
+                memmove(&a[dest], &a[c2], vitorias2 * sizeof(Brinquedo));
+                dest += vitorias2;
+                c2 += vitorias2;
+                len2 -= vitorias2;
+                if (len2 == 0)
+                    goto fim;
             }
+            a[dest++] = tmp[c1++];
+            if (--len1 == 1)
+                goto fim;
+            minGallop--;
+        } while (vitorias1 >= TIM_MIN_GALLOP || vitorias2 >= TIM_MIN_GALLOP);
 
-            for (int i = 0; i < numeroBrinquedos; i++) {
-                orig[i].id = i;
-                if (fscanf(tf, "%19s %lf %lf", orig[i].cor, &orig[i].comprimento, &orig[i].nota) != 3) {
-                    // se falhar na leitura, preencher com valores neutros e ajustar tamanho real
-                    numeroBrinquedos = i;
-                    break;
-                }
+        if (minGallop < 0)
+            minGallop = 0;
+        minGallop += 2; // saiu do galope: fica mais difícil voltar
+    }
+
+fim:
+    st->minGallop = minGallop < 1 ? 1 : minGallop;
+    if (len1 == 1) {
+        memmove(&a[dest], &a[c2], len2 * sizeof(Brinquedo));
+        a[dest + len2] = tmp[c1];
+    }
+    else if (len1 > 0)
+        memcpy(&a[dest], &tmp[c1], len1 * sizeof(Brinquedo));
+}
+
+// Espelho de timIntercalarBaixo para len1 > len2: a segunda corrida vai para o buffer, escrita da direita
+static void timIntercalarAlto(EstadoTimsort *st, int base1, int len1, int base2, int len2) {
+    Brinquedo *a = st->a, *tmp = st->tmp;
+    memcpy(tmp, &a[base2], len2 * sizeof(Brinquedo));
+    int c1 = base1 + len1 - 1, c2 = len2 - 1, dest = base2 + len2 - 1;
+    int minGallop = st->minGallop;
+
+    a[dest--] = a[c1--];
+    if (--len1 == 0) {
+        memcpy(&a[dest - (len2 - 1)], tmp, len2 * sizeof(Brinquedo));
+        return;
+    }
+    if (len2 == 1) {
+        dest -= len1;
+        c1 -= len1;
+        memmove(&a[dest + 1], &a[c1 + 1], len1 * sizeof(Brinquedo));
+        a[dest] = tmp[c2];
+        return;
+    }
+
+    for (;;) {
+        int vitorias1 = 0, vitorias2 = 0;
+
+        do {
+            if (compararBrinquedos(&tmp[c2], &a[c1]) < 0) {
+                a[dest--] = a[c1--];
+                vitorias1++;
+                vitorias2 = 0;
+                if (--len1 == 0)
+                    goto fim;
             }
-            fclose(tf);
-
-            // executar cada algoritmo solicitado e registrar tempo em stderr (CSV)
-            for (int a = 1; a <= 4; a++) {
-                if (!runAlgo[a]) continue;
-                double t = 0.0;
-                executarAlgoritmoCopia(orig, numeroBrinquedos, a, &t);
-                fprintf(stderr, "%s,alg%d,%.6f\n", pathbuf, a, t);
+            else {
+                a[dest--] = tmp[c2--];
+                vitorias2++;
+                vitorias1 = 0;
+                if (--len2 == 1)
+                    goto fim;
             }
+        } while ((vitorias1 | vitorias2) < minGallop);
 
-            free(orig);
-        }
+        do {
+            vitorias1 = len1 - timGalopeDireita(&tmp[c2], &a[base1], len1, len1 - 1);
+            if (vitorias1 != 0) {
+                dest -= vitorias1;
+                c1 -= vitorias1;
+                len1 -= vitorias1;
+                memmove(&a[dest + 1], &a[c1 + 1], vitorias1 * sizeof(Brinquedo));
+                if (len1 == 0)
+                    goto fim;
+            }
+            a[dest--] = tmp[c2--];
+            if (--len2 == 1)
+                goto fim;
 
-        fclose(lf);
-        return 0;
+            vitorias2 = len2 - timGalopeEsquerda(&a[c1], tmp, len2, len2 - 1);
+            if (vitorias2 != 0) {
+                dest -= vitorias2;
+                c2 -= vitorias2;
+                len2 -= vitorias2;
+                memcpy(&a[dest + 1], &tmp[c2 + 1], vitorias2 * sizeof(Brinquedo));
+                if (len2 <= 1)
+                    goto fim;
+            }
+            a[dest--] = a[c1--];
+            if (--len1 == 0)
+                goto fim;
+            minGallop--;
+        } while (vitorias1 >= TIM_MIN_GALLOP || vitorias2 >= TIM_MIN_GALLOP);
+
+        if (minGallop < 0)
+            minGallop = 0;
+        minGallop += 2;
     }
 
-    int numeroBrinquedos = -1, metodoSelecionado = 0;
-    if (scanf("%d", &numeroBrinquedos) != 1) return -1;
+fim:
+    st->minGallop = minGallop < 1 ? 1 : minGallop;
+    if (len2 == 1) {
+        dest -= len1;
+        c1 -= len1;
+        memmove(&a[dest + 1], &a[c1 + 1], len1 * sizeof(Brinquedo));
+        a[dest] = tmp[c2];
+    }
+    else if (len2 > 0)
+        memcpy(&a[dest - (len2 - 1)], tmp, len2 * sizeof(Brinquedo));
+}
 
-    // alocação dinâmica e tratamento para caso de insucesso.
-    Brinquedo *brinquedo = (Brinquedo*)malloc(numeroBrinquedos*sizeof(Brinquedo));
-    if (brinquedo == NULL)
-        return -1;
+// Intercala as corridas i e i + 1 da pilha
+static void timIntercalarEm(EstadoTimsort *st, int i) {
+    int base1 = st->base[i], len1 = st->tamanho[i];
+    int base2 = st->base[i + 1], len2 = st->tamanho[i + 1];
 
-    for (int i = 0; i < numeroBrinquedos; i++) { // loop para leitura formatada dos dados, conforme o runcodes deseja.
-        brinquedo[i].id = i;
-        scanf("%s %lf %lf", brinquedo[i].cor, &brinquedo[i].comprimento, &brinquedo[i].nota);
+    st->tamanho[i] = len1 + len2;
+    if (i == st->topo - 3) {
+        st->base[i + 1] = st->base[i + 2];
+        st->tamanho[i + 1] = st->tamanho[i + 2];
     }
+    st->topo--;
 
-    if (scanf("%d", &metodoSelecionado) != 1) metodoSelecionado = 0; // manter compatibilidade
+    // o começo da primeira corrida que já é <= início da segunda não se move (idem para o fim da segunda)
+    int k = timGalopeDireita(&st->a[base2], &st->a[base1], len1, 0);
+    base1 += k;
+    len1 -= k;
+    if (len1 == 0)
+        return;
 
-    // Medição de desempenho: inicia o relógio antes de executar o algoritmo.
-    clock_t inicio_tempo = clock();
+    len2 = timGalopeEsquerda(&st->a[base1 + len1 - 1], &st->a[base2], len2, len2 - 1);
+    if (len2 == 0)
+        return;
 
-    switch (metodoSelecionado) { // estrutura switch para o condicionamento dos casos de ordenação, no caso, o algoritmo em si.
-        case 1:
-            ordenacaoViaBubbleSort(brinquedo, numeroBrinquedos);
-            break;
-        
-        case 2:
-            ordenacaoViaInsertionSort(brinquedo, numeroBrinquedos);
-            break;
-        case 3:
-            ordenacaoViaMergeSort(brinquedo, 0, numeroBrinquedos - 1);
+    if (len1 <= len2)
+        timIntercalarBaixo(st, base1, len1, base2, len2);
+    else
+        timIntercalarAlto(st, base1, len1, base2, len2);
+}
+
+// Restaura os invariantes da pilha: tamanho[n-1] > tamanho[n] + tamanho[n+1] e tamanho[n] > tamanho[n+1]
+static void timColapsar(EstadoTimsort *st) {
+    while (st->topo > 1) {
+        int n = st->topo - 2;
+        if ((n > 0 && st->tamanho[n - 1] <= st->tamanho[n] + st->tamanho[n + 1]) ||
+            (n > 1 && st->tamanho[n - 2] <= st->tamanho[n] + st->tamanho[n - 1])) {
+            if (st->tamanho[n - 1] < st->tamanho[n + 1])
+                n--;
+        }
+        else if (st->tamanho[n] > st->tamanho[n + 1])
             break;
-        case 4:
-            ordenacaoViaQuickSort(brinquedo, 0, numeroBrinquedos - 1);
+        timIntercalarEm(st, n);
+    }
+}
+
+void ordenacaoViaTimSort(Brinquedo *brinquedo, int numeroBrinquedos) {
+    int n = numeroBrinquedos;
+    if (n <= 1 || brinquedo == NULL)
+        return;
+
+    if (n < TIM_MIN_MERGE) {
+        timInsercaoBinaria(brinquedo, 0, n, timContarCorrida(brinquedo, 0, n));
+        return;
+    }
+
+    EstadoTimsort st;
+    st.a = brinquedo;
+    st.tmp = (Brinquedo *)malloc((n / 2 + 1) * sizeof(Brinquedo)); // maior intercalação usa min(len1, len2) <= n/2
+    if (!st.tmp)
+        return;
+    st.minGallop = TIM_MIN_GALLOP;
+    st.topo = 0;
+
+    int minRun = timMinRun(n), lo = 0, restantes = n;
+    do {
+        int corrida = timContarCorrida(brinquedo, lo, n);
+        if (corrida < minRun) {
+            int forcado = restantes < minRun ? restantes : minRun;
+            timInsercaoBinaria(brinquedo, lo, lo + forcado, lo + corrida);
+            corrida = forcado;
+        }
+
+        st.base[st.topo] = lo;
+        st.tamanho[st.topo] = corrida;
+        st.topo++;
+        timColapsar(&st);
+
+        lo += corrida;
+        restantes -= corrida;
+    } while (restantes != 0);
+
+    // intercala o que sobrou na pilha
+    while (st.topo > 1) {
+        int i = st.topo - 2;
+        if (i > 0 && st.tamanho[i - 1] < st.tamanho[i + 1])
+            i--;
+        timIntercalarEm(&st, i);
+    }
+
+    free(st.tmp);
+}
+
+/* Introsort para Brinquedo (alternativa ao quicksort de pivô fixo do método 4): pivô pela mediana de três
+(ninther, a mediana de três medianas, acima de INTRO_NINTHER registros), partição de Hoare, recursão só no
+lado menor (o maior continua no laço: pilha O(log n)), limite de profundidade 2*log2(n) com heapsort como
+fallback e inserção abaixo de INTRO_CORTE_INSERCAO. Em entradas ordenadas/invertidas (best.in/worst.in) a
+mediana cai no meio e a partição fica balanceada.
+Com -DORDENACAO_GENERICA (e -I <raiz>/benchmark), o introsort e o introselect usam a instância Brinquedo de
+ordenacao_generica.h, com compararBrinquedos expandido dentro dos laços, no lugar da cópia abaixo; sem a flag o
+arquivo continua autocontido para o runcodes. */
+#define INTRO_CORTE_INSERCAO 16 // o mesmo ORDENACAO_CORTE_INSERCAO da instância genérica
+#define INTRO_NINTHER 128
+
+#ifdef ORDENACAO_GENERICA
+#define ORDENACAO_TIPO Brinquedo
+#define ORDENACAO_SUFIXO brinquedo
+#define ORDENACAO_MENOR(a, b) (compararBrinquedos((a), (b)) < 0)
+#include "ordenacao_generica.h"
+
+// Intervalos fechados [lo, hi], como na cópia manual
+#define introInsercao(a, lo, hi) insercao_intervalo_brinquedo((a), (lo), (hi) + 1)
+#define introHeapsort(a, lo, hi) heapsort_intervalo_brinquedo((a), (lo), (hi) + 1)
+#define introParticiona(a, lo, hi) particiona_brinquedo((a), (lo), (hi))
+
+void ordenacaoViaIntroSort(Brinquedo *brinquedo, int numeroBrinquedos) {
+    introsort_brinquedo(brinquedo, numeroBrinquedos);
+}
+#else
+static void introInsercao(Brinquedo *a, int lo, int hi) { // [lo, hi]
+    for (int i = lo + 1; i <= hi; i++) {
+        Brinquedo chave = a[i];
+        int j = i - 1;
+        while (j >= lo && compararBrinquedos(&a[j], &chave) > 0) {
+            a[j + 1] = a[j];
+            j--;
+        }
+        a[j + 1] = chave;
+    }
+}
+
+// Desce a[base + i] no heap de máximo a[base..base + n)
+static void introPeneirar(Brinquedo *a, int base, int i, int n) {
+    Brinquedo x = a[base + i];
+    for (;;) {
+        int filho = 2 * i + 1;
+        if (filho >= n)
+            break;
+        if (filho + 1 < n && compararBrinquedos(&a[base + filho], &a[base + filho + 1]) < 0)
+            filho++;
+        if (compararBrinquedos(&x, &a[base + filho]) >= 0)
+            break;
+        a[base + i] = a[base + filho];
+        i = filho;
+    }
+    a[base + i] = x;
+}
+
+static void introHeapsort(Brinquedo *a, int lo, int hi) {
+    int n = hi - lo + 1;
+    for (int i = n / 2 - 1; i >= 0; i--)
+        introPeneirar(a, lo, i, n);
+    for (int fim = n - 1; fim > 0; fim--) {
+        capitaoGinyu(&a[lo], &a[lo + fim]);
+        introPeneirar(a, lo, 0, fim);
+    }
+}
+
+static int introMediana3(const Brinquedo *a, int i, int j, int k) {
+    if (compararBrinquedos(&a[i], &a[j]) < 0) {
+        if (compararBrinquedos(&a[j], &a[k]) < 0) return j;
+        return compararBrinquedos(&a[i], &a[k]) < 0 ? k : i;
+    }
+    if (compararBrinquedos(&a[i], &a[k]) < 0) return i;
+    return compararBrinquedos(&a[j], &a[k]) < 0 ? k : j;
+}
+
+// Hoare com o pivô (mediana) em a[lo]; devolve j com a[lo..j] <= pivô <= a[j+1..hi], lo <= j < hi
+static int introParticiona(Brinquedo *a, int lo, int hi) {
+    int n = hi - lo + 1, meio = lo + n / 2, m;
+    if (n > INTRO_NINTHER) {
+        int d = n / 8;
+        m = introMediana3(a, introMediana3(a, lo, lo + d, lo + 2 * d),
+                             introMediana3(a, meio - d, meio, meio + d),
+                             introMediana3(a, hi - 2 * d, hi - d, hi));
+    }
+    else
+        m = introMediana3(a, lo, meio, hi);
+    capitaoGinyu(&a[lo], &a[m]);
+
+    Brinquedo pivo = a[lo];
+    int i = lo - 1, j = hi + 1;
+    for (;;) {
+        do i++; while (compararBrinquedos(&a[i], &pivo) < 0);
+        do j--; while (compararBrinquedos(&a[j], &pivo) > 0);
+        if (i >= j)
+            return j;
+        capitaoGinyu(&a[i], &a[j]);
+    }
+}
+
+static void introsortRecursivo(Brinquedo *a, int lo, int hi, int profundidade) {
+    while (hi - lo + 1 > INTRO_CORTE_INSERCAO) {
+        if (profundidade-- == 0) {
+            introHeapsort(a, lo, hi);
+            return;
+        }
+
+        int p = introParticiona(a, lo, hi);
+        if (p - lo < hi - p) {
+            introsortRecursivo(a, lo, p, profundidade);
+            lo = p + 1;
+        }
+        else {
+            introsortRecursivo(a, p + 1, hi, profundidade);
+            hi = p;
+        }
+    }
+    introInsercao(a, lo, hi);
+}
+
+void ordenacaoViaIntroSort(Brinquedo *brinquedo, int numeroBrinquedos) {
+    if (numeroBrinquedos <= 1 || brinquedo == NULL)
+        return;
+
+    int profundidade = 0;
+    for (int n = numeroBrinquedos; n > 1; n >>= 1)
+        profundidade += 2;
+    introsortRecursivo(brinquedo, 0, numeroBrinquedos - 1, profundidade);
+}
+#endif
+
+/* Introselect (--top K com a entrada já em memória): as mesmas partições do introsort, mas só o lado que contém
+a posição k-1 continua, então o custo esperado é O(n); estourando o limite de profundidade, o intervalo que
+sobrou é ordenado por heapsort. Ao final brinquedo[0..k) são os k menores, já ordenados (introsort só neles). */
+void selecionarMenores(Brinquedo *brinquedo, int numeroBrinquedos, int k) {
+    if (k > numeroBrinquedos)
+        k = numeroBrinquedos;
+    if (k <= 0 || brinquedo == NULL)
+        return;
+
+    int lo = 0, hi = numeroBrinquedos - 1, profundidade = 0;
+    for (int n = numeroBrinquedos; n > 1; n >>= 1)
+        profundidade += 2;
+
+    while (hi - lo + 1 > INTRO_CORTE_INSERCAO) {
+        if (profundidade-- == 0) {
+            introHeapsort(brinquedo, lo, hi);
+            break;
+        }
+
+        int p = introParticiona(brinquedo, lo, hi);
+        if (k - 1 <= p)
+            hi = p;
+        else
+            lo = p + 1;
+    }
+    if (hi - lo + 1 <= INTRO_CORTE_INSERCAO)
+        introInsercao(brinquedo, lo, hi);
+
+    ordenacaoViaIntroSort(brinquedo, k);
+}
+
+/* Método 10: merge sort paralelo (pthreads), estável e com a mesma saída de ordenacaoViaMergeSort. O vetor é
+cortado em T blocos, ordenados em paralelo (merge sort com arena, cada thread na sua fatia); depois, a cada
+rodada, pares de corridas vizinhas são intercalados. Para que as últimas rodadas (poucas intercalações grandes)
+também escalem, a thread t fica com a fatia [n*t/T, n*(t+1)/T) da SAÍDA e descobre por co-ranking (busca
+binária) quantos elementos de cada corrida caem antes dela; empates vão para a corrida da esquerda. As rodadas
+alternam vetor/arena; com número ímpar de rodadas os blocos ordenados são copiados para a arena (cada thread o
+seu), para que a última rodada escreva no vetor sem precisar de outra barreira. */
+#define PARALELO_MINIMO 2048 // elementos mínimos por thread: abaixo disso, criar threads custa mais que ordenar
+
+/* Co-rank: quantos elementos de a[0..m) ficam entre os k primeiros da intercalação estável de a com b, isto é,
+o i tal que a[i-1] <= b[k-i] e b[k-i-1] < a[i]. */
+static int coRank(int k, const Brinquedo *a, int m, const Brinquedo *b, int n) {
+    int i = k < m ? k : m, j = k - i;
+    int iMin = k - n > 0 ? k - n : 0, jMin = k - m > 0 ? k - m : 0;
+
+    for (;;) {
+        if (i > 0 && j < n && compararBrinquedos(&a[i - 1], &b[j]) > 0) { // i grande demais
+            int delta = (i - iMin + 1) / 2;
+            jMin = j;
+            i -= delta;
+            j += delta;
+        }
+        else if (j > 0 && i < m && compararBrinquedos(&b[j - 1], &a[i]) >= 0) { // j grande demais
+            int delta = (j - jMin + 1) / 2;
+            iMin = i;
+            i += delta;
+            j -= delta;
+        }
+        else
+            return i;
+    }
+}
+
+typedef struct {
+    Brinquedo *vetor, *arena;
+    int n, threads, fatia; // a thread 'fatia' de 'threads'
+    int bloco;             // tamanho dos blocos iniciais
+    int largura;           // corridas da rodada (0: fase de ordenação dos blocos)
+    bool paraArena;        // direção da rodada (na fase dos blocos: a da primeira rodada)
+} TarefaMergeParalelo;
+
+static void *trabalhoMergeParalelo(void *arg) {
+    const TarefaMergeParalelo *t = (const TarefaMergeParalelo *)arg;
+
+    if (t->largura == 0) {
+        long long inicio = (long long)t->bloco * t->fatia;
+        if (inicio < t->n) {
+            int tamanho = t->n - inicio < t->bloco ? t->n - (int)inicio : t->bloco;
+            ordenacaoViaMergeSortArena(t->vetor + inicio, tamanho, t->arena + inicio);
+            if (!t->paraArena)
+                memcpy(t->arena + inicio, t->vetor + inicio, tamanho * sizeof(Brinquedo));
+        }
+        return NULL;
+    }
+
+    const Brinquedo *src = t->paraArena ? t->vetor : t->arena;
+    Brinquedo *dst = t->paraArena ? t->arena : t->vetor;
+    int inicioSaida = (int)((long long)t->n * t->fatia / t->threads);
+    int fimSaida = (int)((long long)t->n * (t->fatia + 1) / t->threads);
+    long long passo = 2LL * t->largura;
+
+    // intercalações [par, fim) que cruzam a fatia de saída, cada uma restrita às posições [k0, k1)
+    for (long long par = inicioSaida / passo * passo; par < fimSaida; par += passo) {
+        int meio = par + t->largura < t->n ? (int)par + t->largura : t->n;
+        int fim = par + passo < t->n ? (int)(par + passo) : t->n;
+        int k0 = (inicioSaida > par ? inicioSaida : (int)par) - (int)par;
+        int k1 = (fimSaida < fim ? fimSaida : fim) - (int)par;
+        const Brinquedo *esquerda = src + par, *direita = src + meio;
+        int i0 = coRank(k0, esquerda, meio - (int)par, direita, fim - meio);
+        int i1 = coRank(k1, esquerda, meio - (int)par, direita, fim - meio);
+
+        const Brinquedo *a = esquerda + i0, *aFim = esquerda + i1;
+        const Brinquedo *b = direita + (k0 - i0), *bFim = direita + (k1 - i1);
+        Brinquedo *saida = dst + par + k0;
+        while (a < aFim && b < bFim) {
+            if (compararBrinquedos(a, b) <= 0)
+                *saida++ = *a++;
+            else
+                *saida++ = *b++;
+        }
+        memcpy(saida, a, (aFim - a) * sizeof(Brinquedo));
+        memcpy(saida + (aFim - a), b, (bFim - b) * sizeof(Brinquedo));
+    }
+    return NULL;
+}
+
+// numeroThreads <= 0: um por núcleo. Sem pthreads (Windows) ou com n pequeno, cai no merge sort sequencial.
+void ordenacaoViaMergeSortParalelo(Brinquedo *brinquedo, int numeroBrinquedos, int numeroThreads) {
+    int n = numeroBrinquedos;
+    if (n <= 1 || brinquedo == NULL)
+        return;
+
+#ifndef _WIN32
+    if (numeroThreads <= 0) {
+        long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        numeroThreads = nucleos > 0 ? (int)nucleos : 1;
+    }
+    if (numeroThreads > n / PARALELO_MINIMO)
+        numeroThreads = n / PARALELO_MINIMO;
+
+    Brinquedo *arena = NULL;
+    pthread_t *threads = NULL;
+    TarefaMergeParalelo *tarefas = NULL;
+    if (numeroThreads > 1) {
+        arena = (Brinquedo *)malloc(n * sizeof(Brinquedo));
+        threads = (pthread_t *)malloc(numeroThreads * sizeof(pthread_t));
+        tarefas = (TarefaMergeParalelo *)malloc(numeroThreads * sizeof(TarefaMergeParalelo));
+    }
+    if (!arena || !threads || !tarefas) {
+        free(arena);
+        free(threads);
+        free(tarefas);
+        ordenacaoViaMergeSort(brinquedo, 0, n - 1);
+        return;
+    }
+
+    // blocos de tamanho teto(n/T): as corridas da rodada r têm bloco*2^r elementos (a última pode ser menor)
+    int bloco = (n + numeroThreads - 1) / numeroThreads;
+    int rodadas = 0;
+    for (long long w = bloco; w < n; w *= 2)
+        rodadas++;
+
+    bool paraArena = rodadas % 2 == 0; // escolhido para que a última rodada termine no vetor
+    for (int r = -1; r < rodadas; r++) {
+        int criadas = 0;
+        for (int t = 0; t < numeroThreads; t++)
+            tarefas[t] = (TarefaMergeParalelo){ brinquedo, arena, n, numeroThreads, t, bloco,
+                                                r < 0 ? 0 : bloco << r, paraArena };
+
+        // a thread chamadora faz a fatia 0; se uma criação falhar, ela faz as que sobraram
+        for (int t = 1; t < numeroThreads; t++) {
+            if (pthread_create(&threads[t], NULL, trabalhoMergeParalelo, &tarefas[t]) != 0)
+                break;
+            criadas++;
+        }
+        trabalhoMergeParalelo(&tarefas[0]);
+        for (int t = criadas + 1; t < numeroThreads; t++)
+            trabalhoMergeParalelo(&tarefas[t]);
+        for (int t = 1; t <= criadas; t++)
+            pthread_join(threads[t], NULL);
+
+        if (r >= 0)
+            paraArena = !paraArena;
+    }
+
+    free(arena);
+    free(threads);
+    free(tarefas);
+#else
+    (void)numeroThreads;
+    ordenacaoViaMergeSort(brinquedo, 0, n - 1);
+#endif
+}
+
+// Copia n elementos de src para dst
+void copiarVetor(Brinquedo *dst, const Brinquedo *src, int n) {
+    if (n <= 0) return;
+    memcpy(dst, src, n * sizeof(Brinquedo));
+}
+
+#ifdef CONTADORES_HW
+_Thread_local LeituraHW ultimaLeituraHW; // contadores da última chamada de executarAlgoritmoCopia (na thread)
+#endif
+
+// Tempo de CPU da thread chamadora em segundos (como clock(), mas sem somar as outras threads do --jobs)
+static double tempoCpuThread(void) {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#else
+    return (double)clock() / (double)CLOCKS_PER_SEC;
+#endif
+}
+
+// Métodos selecionáveis (entrada do runcodes e --batch): 1..NUMERO_ALGORITMOS
+#define NUMERO_ALGORITMOS 10
+#define METODO_PARALELO 10 // o único multithread: cronometrado em tempo de parede
+
+// Tempo de parede em segundos (o tempo de CPU da thread não enxerga o trabalho das outras threads)
+static double tempoParede(void) {
+#if defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#else
+    return (double)clock() / (double)CLOCKS_PER_SEC;
+#endif
+}
+
+/* Executa um algoritmo sobre uma cópia dos dados originais, retorna tempo em segundos. 'threads' só vale para o
+método paralelo (<= 0: um por núcleo). */
+void executarAlgoritmoCopia(const Brinquedo *orig, int n, int metodo, int threads, double *tempo_out) {
+    Brinquedo *tmp = (Brinquedo*)malloc(n * sizeof(Brinquedo));
+    if (!tmp) {
+        *tempo_out = -1.0;
+        return;
+    }
+    copiarVetor(tmp, orig, n);
+#ifdef CONTADORES_HW
+    static _Thread_local ContadoresHW contadores; // perf_event_open(pid = 0) mede só a thread que abriu
+    static _Thread_local bool contadoresAbertos = false;
+    if (!contadoresAbertos) {
+        contadores_abrir(&contadores);
+        contadoresAbertos = true;
+    }
+    contagemComparacoes = contagemTrocas = 0;
+    contadores_iniciar(&contadores);
+#endif
+    double (*relogio)(void) = metodo == METODO_PARALELO ? tempoParede : tempoCpuThread;
+    double start = relogio();
+    switch (metodo) {
+        case 1: ordenacaoViaBubbleSort(tmp, n); break;
+        case 2: ordenacaoViaInsertionSort(tmp, n); break;
+        case 3: ordenacaoViaMergeSort(tmp, 0, n - 1); break;
+        case 4: ordenacaoViaQuickSort(tmp, 0, n - 1); break;
+        case 5: ordenacaoViaRadixSort(tmp, n); break;
+        case 6: ordenacaoViaIndices(tmp, n); break;
+        case 7: ordenacaoViaSoA(tmp, n); break;
+        case 8: ordenacaoViaTimSort(tmp, n); break;
+        case 9: ordenacaoViaIntroSort(tmp, n); break;
+        case 10: ordenacaoViaMergeSortParalelo(tmp, n, threads); break;
+        default: break;
+    }
+    double end = relogio();
+#ifdef CONTADORES_HW
+    contadores_parar(&contadores, &ultimaLeituraHW);
+#endif
+    *tempo_out = end - start;
+    free(tmp);
+}
+
+/* Leitura rápida da entrada: o arquivo inteiro é mapeado em memória (mmap; stdin também, quando redirecionado
+de um arquivo) ou, se não der (pipe, Windows), lido num único buffer. Os tokens são consumidos direto do buffer,
+sem cópia nem scanf; as cores são internadas durante a leitura. */
+typedef struct {
+    char *dados;
+    size_t tamanho;
+    void *mapa;        // região do mmap (NULL quando lido com fread; aí dados é do malloc)
+    size_t tamanhoMapa;
+} EntradaBruta;
+
+static bool lerEntradaBruta(FILE *f, EntradaBruta *e) {
+    e->dados = NULL;
+    e->tamanho = 0;
+    e->mapa = NULL;
+    e->tamanhoMapa = 0;
+
+#ifndef _WIN32
+    struct stat st;
+    int fd = fileno(f);
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        off_t inicio = lseek(fd, 0, SEEK_CUR); // stdin pode já ter sido parcialmente lido
+        if (inicio < 0 || inicio > st.st_size)
+            inicio = 0;
+
+        void *m = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (m != MAP_FAILED) {
+            madvise(m, (size_t)st.st_size, MADV_SEQUENTIAL);
+            e->mapa = m;
+            e->tamanhoMapa = (size_t)st.st_size;
+            e->dados = (char *)m + inicio; // ignora o que já foi consumido
+            e->tamanho = (size_t)(st.st_size - inicio);
+            return true;
+        }
+    }
+#endif
+
+    size_t capacidade = 1 << 16;
+    e->dados = (char *)malloc(capacidade);
+    if (!e->dados)
+        return false;
+
+    size_t lidos;
+    while ((lidos = fread(e->dados + e->tamanho, 1, capacidade - e->tamanho, f)) > 0) {
+        e->tamanho += lidos;
+        if (e->tamanho == capacidade) {
+            char *maior = (char *)realloc(e->dados, capacidade * 2);
+            if (!maior) {
+                free(e->dados);
+                e->dados = NULL;
+                return false;
+            }
+            e->dados = maior;
+            capacidade *= 2;
+        }
+    }
+    return true;
+}
+
+static void liberarEntradaBruta(EntradaBruta *e) {
+#ifndef _WIN32
+    if (e->mapa) {
+        munmap(e->mapa, e->tamanhoMapa);
+        e->mapa = NULL;
+        e->dados = NULL;
+        return;
+    }
+#endif
+    free(e->dados);
+    e->dados = NULL;
+}
+
+static inline bool ehEspaco(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+static inline const char *pularEspacos(const char *p, const char *fim) {
+    while (p < fim && ehEspaco(*p))
+        p++;
+    return p;
+}
+
+static const char *lerInteiro(const char *p, const char *fim, int *valor, bool *ok) {
+    p = pularEspacos(p, fim);
+    bool negativo = false;
+    if (p < fim && (*p == '-' || *p == '+'))
+        negativo = (*p++ == '-');
+
+    const char *inicio = p;
+    long long v = 0;
+    while (p < fim && *p >= '0' && *p <= '9' && v < 100000000000LL)
+        v = v * 10 + (*p++ - '0');
+
+    *ok = p > inicio;
+    *valor = (int)(negativo ? -v : v);
+    return p;
+}
+
+/* double: caminho rápido para [-]ddd[.dd...] com até 15 dígitos no total. A mantissa inteira
+m (< 10^15 < 2^53) e 10^k (k <= 15) são exatos em double, e a divisão IEEE é corretamente arredondada, logo o
+resultado é o mesmo de strtod. Expoente, muitos dígitos, inf/nan etc. caem no strtod. */
+static const char *lerDouble(const char *p, const char *fim, double *valor, bool *ok) {
+    static const double potencia10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+                                         1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15 };
+    p = pularEspacos(p, fim);
+    const char *token = p;
+    bool negativo = false;
+    if (p < fim && (*p == '-' || *p == '+'))
+        negativo = (*p++ == '-');
+
+    uint64_t m = 0;
+    int digitos = 0, decimais = 0;
+    while (p < fim && *p >= '0' && *p <= '9') {
+        m = m * 10 + (uint64_t)(*p++ - '0');
+        digitos++;
+    }
+    if (p < fim && *p == '.') {
+        p++;
+        while (p < fim && *p >= '0' && *p <= '9') {
+            m = m * 10 + (uint64_t)(*p++ - '0');
+            digitos++;
+            decimais++;
+        }
+    }
+
+    if (digitos > 0 && digitos <= 15 && (p == fim || ehEspaco(*p))) {
+        double v = (double)m / potencia10[decimais];
+        *valor = negativo ? -v : v;
+        *ok = true;
+        return p;
+    }
+
+    // fallback: copia o token (terminado em '\0') para o strtod
+    char buf[64];
+    size_t len = 0;
+    p = token;
+    while (p < fim && !ehEspaco(*p) && len < sizeof(buf) - 1)
+        buf[len++] = *p++;
+    buf[len] = '\0';
+
+    char *resto;
+    *valor = strtod(buf, &resto);
+    *ok = len > 0 && resto != buf;
+    return token + (resto - buf);
+}
+
+// cor: como "%19s" (no máximo 19 caracteres; o restante do token é ignorado)
+static const char *lerCor(const char *p, const char *fim, char *cor, bool *ok) {
+    p = pularEspacos(p, fim);
+    int len = 0;
+    while (p < fim && !ehEspaco(*p)) {
+        if (len < 19)
+            cor[len++] = *p;
+        p++;
+    }
+    cor[len] = '\0';
+    *ok = len > 0;
+    return p;
+}
+
+/* Formato do runcodes: n, n linhas "cor comprimento nota" e, opcionalmente, o método. Devolve o vetor com
+ids e postos preenchidos (NULL em falha); registros malformados encerram a leitura, ajustando *n. */
+Brinquedo *carregarBrinquedos(FILE *f, int *numeroBrinquedos, int *metodo) {
+    EntradaBruta e;
+    if (!lerEntradaBruta(f, &e))
+        return NULL;
+
+    const char *p = e.dados, *fim = e.dados + e.tamanho;
+    bool ok;
+    int n = 0;
+    p = lerInteiro(p, fim, &n, &ok);
+    if (!ok || n < 0) {
+        liberarEntradaBruta(&e);
+        return NULL;
+    }
+
+    Brinquedo *brinquedo = (Brinquedo *)malloc((n > 0 ? n : 1) * sizeof(Brinquedo));
+    if (!brinquedo) {
+        liberarEntradaBruta(&e);
+        return NULL;
+    }
+
+    TabelaCores cores;
+    iniciarTabelaCores(&cores);
+    int lidos = 0;
+    for (; lidos < n; lidos++) {
+        Brinquedo *b = &brinquedo[lidos];
+        b->id = lidos;
+        p = lerCor(p, fim, b->cor, &ok);
+        if (!ok)
+            break;
+        p = lerDouble(p, fim, &b->comprimento, &ok);
+        if (!ok)
+            break;
+        p = lerDouble(p, fim, &b->nota, &ok);
+        if (!ok)
+            break;
+        b->posto = internarCor(&cores, b->cor);
+        if (b->posto < 0)
+            break;
+    }
+
+    if (metodo) {
+        p = lerInteiro(p, fim, metodo, &ok);
+        if (!ok)
+            *metodo = 0;
+    }
+    liberarEntradaBruta(&e);
+
+    bool coresOk = finalizarCores(&cores, brinquedo, lidos);
+    liberarTabelaCores(&cores);
+    if (!coresOk) {
+        free(brinquedo);
+        return NULL;
+    }
+
+    *numeroBrinquedos = lidos;
+    return brinquedo;
+}
+
+/* --externo: ordenação externa para entradas maiores que a memória. A entrada é lida em fluxo (buffer fixo,
+sem carregar o arquivo inteiro) em blocos que cabem no orçamento; cada bloco é ordenado por indireção
+(método 6) e gravado já na ordem final, como uma corrida binária, num arquivo temporário único. Depois uma
+árvore de perdedores intercala as corridas (em mais de uma passada se não houver memória para um buffer por
+corrida) e os ids saem direto em stdout, no formato "id;" do runcodes. Se tudo couber num bloco, nada vai
+para o disco. O método na última linha da entrada é ignorado. */
+#define EXTERNO_JANELA 4096            // bytes garantidos à frente do cursor ao ler um registro
+#define EXTERNO_LEITURA (1 << 20)      // buffer da leitura em fluxo
+#define EXTERNO_BUFFER_MINIMO (1 << 16) // bytes mínimos de buffer por corrida na intercalação
+#define EXTERNO_BYTES_POR_REGISTRO (sizeof(Brinquedo) + 2 * sizeof(ParChaveIndice) + sizeof(uint32_t))
+#define EXTERNO_BLOCO_MINIMO 1024      // registros por bloco da fase 1, no mínimo
+// Piso do orçamento: o buffer de leitura e o menor bloco são alocados de qualquer jeito (~1.1 MB)
+#define EXTERNO_ORCAMENTO_MINIMO (EXTERNO_LEITURA + EXTERNO_BLOCO_MINIMO * EXTERNO_BYTES_POR_REGISTRO)
+
+#ifdef _WIN32
+#define posicionarArquivo(f, pos) _fseeki64((f), (pos), SEEK_SET)
+#else
+#define posicionarArquivo(f, pos) fseeko((f), (off_t)(pos), SEEK_SET)
+#endif
+
+/* Registro das corridas (40 bytes): chaves já codificadas como no método 6, para que a intercalação compare
+inteiros. A cor vai como texto completado com '\0' (memcmp dá a ordem do strcmp), porque os postos de um
+bloco não valem nos outros. */
+typedef struct {
+    uint64_t comprimento; // chaveDouble(comprimento)
+    uint64_t nota;        // ~chaveDouble(nota): maior nota primeiro
+    int32_t id;
+    char cor[20];
+} RegistroCorrida;
+
+static inline bool registroMenor(const RegistroCorrida *a, const RegistroCorrida *b) {
+    int c = memcmp(a->cor, b->cor, sizeof(a->cor));
+    if (c != 0)
+        return c < 0;
+    if (a->comprimento != b->comprimento)
+        return a->comprimento < b->comprimento;
+    if (a->nota != b->nota)
+        return a->nota < b->nota;
+    return a->id < b->id;
+}
+
+typedef struct {
+    long long inicio, quantidade; // em registros, dentro do arquivo temporário
+} Corrida;
+
+typedef struct {
+    FILE *f;
+    char *buf;
+    size_t ini, fim;
+    bool eof;
+} LeitorFluxo;
+
+// Move o resto do buffer para o começo e lê mais, até haver EXTERNO_JANELA bytes à frente ou acabar a entrada
+static void garantirJanela(LeitorFluxo *l) {
+    if (l->eof || l->fim - l->ini >= EXTERNO_JANELA)
+        return;
+
+    memmove(l->buf, l->buf + l->ini, l->fim - l->ini);
+    l->fim -= l->ini;
+    l->ini = 0;
+    while (!l->eof && l->fim < EXTERNO_JANELA) {
+        size_t lidos = fread(l->buf + l->fim, 1, EXTERNO_LEITURA - l->fim, l->f);
+        if (lidos == 0)
+            l->eof = true;
+        l->fim += lidos;
+    }
+}
+
+// Arquivo temporário binário, já removido do diretório (o espaço volta quando ele é fechado)
+static FILE *criarTemporario(const char *dir) {
+#ifndef _WIN32
+    if (dir) {
+        char caminho[1200];
+        snprintf(caminho, sizeof(caminho), "%s/byronXXXXXX", dir);
+        int fd = mkstemp(caminho);
+        if (fd < 0)
+            return NULL;
+        unlink(caminho);
+        FILE *f = fdopen(fd, "w+b");
+        if (!f)
+            close(fd);
+        return f;
+    }
+#else
+    (void)dir;
+#endif
+    return tmpfile();
+}
+
+typedef struct {
+    char buf[1 << 16];
+    size_t usado;
+} SaidaIds;
+
+// "id;" sem printf (ids não são negativos)
+static void escreverId(SaidaIds *s, int id) {
+    if (s->usado > sizeof(s->buf) - 16) {
+        fwrite(s->buf, 1, s->usado, stdout);
+        s->usado = 0;
+    }
+
+    char digitos[12];
+    int len = 0;
+    unsigned int v = (unsigned int)id;
+    do {
+        digitos[len++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+    while (len)
+        s->buf[s->usado++] = digitos[--len];
+    s->buf[s->usado++] = ';';
+}
+
+typedef struct {
+    RegistroCorrida *buf;
+    size_t pos, qtd, capacidade;
+    long long proximo, restante; // próximo registro a ler do arquivo e quantos faltam
+    bool erro;                   // seek ou leitura curta: a intercalação inteira falha
+} LeitorCorrida;
+
+// Próximo registro da corrida (recarregando o buffer do arquivo compartilhado); false quando ela acabou ou em erro
+static bool avancarCorrida(LeitorCorrida *c, FILE *arquivo) {
+    if (++c->pos < c->qtd)
+        return true;
+
+    c->pos = c->qtd = 0;
+    if (c->restante == 0)
+        return false;
+    size_t pedir = c->restante < (long long)c->capacidade ? (size_t)c->restante : c->capacidade;
+    if (posicionarArquivo(arquivo, c->proximo * (long long)sizeof(RegistroCorrida)) != 0
+        || fread(c->buf, sizeof(RegistroCorrida), pedir, arquivo) != pedir) {
+        c->erro = true; // corrida truncada: melhor falhar do que perder registros em silêncio
+        c->restante = 0;
+        return false;
+    }
+    c->qtd = pedir;
+    c->proximo += (long long)pedir;
+    c->restante -= (long long)pedir;
+    return true;
+}
+
+static inline bool corridaMenor(const LeitorCorrida *leitor, int a, int b) {
+    if (leitor[a].qtd == 0) // esgotadas perdem sempre
+        return false;
+    if (leitor[b].qtd == 0)
+        return true;
+    return registroMenor(&leitor[a].buf[leitor[a].pos], &leitor[b].buf[leitor[b].pos]);
+}
+
+/* Intercala as k corridas de 'arquivo' com uma árvore de perdedores: a folha i fica no nó k + i, arvore[1..k)
+guarda o perdedor de cada jogo e arvore[0] o vencedor, então cada registro custa ~log2(k) comparações (só o
+caminho da folha vencedora é rejogado). A saída vira uma nova corrida em 'destino' ou, sem destino, ids. */
+static bool intercalarCorridas(FILE *arquivo, const Corrida *corridas, int k, size_t memoria, FILE *destino,
+                               SaidaIds *ids) {
+    size_t capacidade = memoria / ((size_t)(k + 1) * sizeof(RegistroCorrida));
+    if (capacidade == 0) // orçamento menor que um registro por buffer: lê de um em um em vez de nada
+        capacidade = 1;
+    LeitorCorrida *leitor = (LeitorCorrida *)calloc(k, sizeof(LeitorCorrida));
+    int *arvore = (int *)malloc(2 * k * sizeof(int));
+    int *vencedor = (int *)malloc(2 * k * sizeof(int));
+    RegistroCorrida *saida = (RegistroCorrida *)malloc(capacidade * sizeof(RegistroCorrida));
+    bool ok = leitor && arvore && vencedor && saida;
+
+    for (int i = 0; ok && i < k; i++) {
+        leitor[i].buf = (RegistroCorrida *)malloc(capacidade * sizeof(RegistroCorrida));
+        leitor[i].capacidade = capacidade;
+        leitor[i].proximo = corridas[i].inicio;
+        leitor[i].restante = corridas[i].quantidade;
+        ok = leitor[i].buf != NULL;
+        if (ok) {
+            avancarCorrida(&leitor[i], arquivo); // pos = qtd = 0: carrega o primeiro bloco
+            ok = !leitor[i].erro;
+        }
+    }
+
+    if (ok) {
+        for (int i = 0; i < k; i++)
+            vencedor[k + i] = i;
+        for (int no = k - 1; no >= 1; no--) {
+            int a = vencedor[2 * no], b = vencedor[2 * no + 1];
+            bool bVence = corridaMenor(leitor, b, a);
+            vencedor[no] = bVence ? b : a;
+            arvore[no] = bVence ? a : b;
+        }
+        arvore[0] = k > 1 ? vencedor[1] : 0;
+
+        size_t naSaida = 0;
+        for (;;) {
+            int w = arvore[0];
+            if (leitor[w].qtd == 0)
+                break;
+
+            const RegistroCorrida *r = &leitor[w].buf[leitor[w].pos];
+            if (destino) {
+                saida[naSaida++] = *r;
+                if (naSaida == capacidade) {
+                    ok = ok && fwrite(saida, sizeof(RegistroCorrida), naSaida, destino) == naSaida;
+                    naSaida = 0;
+                }
+            }
+            else
+                escreverId(ids, r->id);
+
+            if (!avancarCorrida(&leitor[w], arquivo) && leitor[w].erro) {
+                ok = false;
+                break;
+            }
+            for (int no = (k + w) / 2; no >= 1; no /= 2) {
+                if (corridaMenor(leitor, arvore[no], w)) {
+                    int t = arvore[no];
+                    arvore[no] = w;
+                    w = t;
+                }
+            }
+            arvore[0] = w;
+        }
+        for (int i = 0; i < k; i++)
+            ok = ok && !leitor[i].erro;
+        if (destino && naSaida > 0)
+            ok = ok && fwrite(saida, sizeof(RegistroCorrida), naSaida, destino) == naSaida;
+        ok = ok && !ferror(arquivo);
+    }
+
+    for (int i = 0; leitor && i < k; i++)
+        free(leitor[i].buf);
+    free(leitor);
+    free(arvore);
+    free(vencedor);
+    free(saida);
+    return ok;
+}
+
+// Grava o bloco na ordem dada como uma corrida no fim de 'arquivo'
+static inline void montarRegistro(RegistroCorrida *r, const Brinquedo *b) {
+    r->comprimento = chaveDouble(b->comprimento);
+    r->nota = ~chaveDouble(b->nota);
+    r->id = b->id;
+    memset(r->cor, 0, sizeof(r->cor));
+    memcpy(r->cor, b->cor, strlen(b->cor)); // cor tem no máximo 19 caracteres
+}
+
+static bool gravarCorrida(FILE *arquivo, const Brinquedo *bloco, const uint32_t *ordem, int m) {
+    RegistroCorrida buf[1024];
+    int usados = 0;
+    for (int i = 0; i < m; i++) {
+        montarRegistro(&buf[usados++], &bloco[ordem[i]]);
+        if (usados == 1024 || i == m - 1) {
+            if (fwrite(buf, sizeof(RegistroCorrida), usados, arquivo) != (size_t)usados)
+                return false;
+            usados = 0;
+        }
+    }
+    return true;
+}
+
+// Primeira linha da entrada (n)
+static bool lerCabecalhoFluxo(LeitorFluxo *l, int *n) {
+    bool ok;
+    garantirJanela(l);
+    const char *p = lerInteiro(l->buf + l->ini, l->buf + l->fim, n, &ok);
+    if (!ok || *n < 0) {
+        fprintf(stderr, "Formato inválido: esperado o número de brinquedos.\n");
+        return false;
+    }
+    l->ini = (size_t)(p - l->buf);
+    return true;
+}
+
+// Próximo "cor comprimento nota" do fluxo (sem id nem posto); false se a entrada acabou ou está malformada
+static bool lerBrinquedoFluxo(LeitorFluxo *l, Brinquedo *b) {
+    bool ok;
+    garantirJanela(l);
+    const char *p = l->buf + l->ini, *fim = l->buf + l->fim;
+    p = lerCor(p, fim, b->cor, &ok);
+    if (ok)
+        p = lerDouble(p, fim, &b->comprimento, &ok);
+    if (ok)
+        p = lerDouble(p, fim, &b->nota, &ok);
+    if (ok)
+        l->ini = (size_t)(p - l->buf);
+    return ok;
+}
+
+/* Lê de 'entrada' até 'capacidade' registros (ids a partir de 'primeiroId'), com postos de cor locais ao
+bloco. Devolve quantos foram lidos, ou -1 se faltar memória. */
+static int lerBlocoFluxo(LeitorFluxo *l, Brinquedo *bloco, int capacidade, int primeiroId) {
+    TabelaCores cores;
+    iniciarTabelaCores(&cores);
+
+    int m = 0;
+    for (; m < capacidade; m++) {
+        Brinquedo *b = &bloco[m];
+        if (!lerBrinquedoFluxo(l, b))
+            break;
+        b->id = primeiroId + m;
+        b->posto = internarCor(&cores, b->cor);
+        if (b->posto < 0) {
+            liberarTabelaCores(&cores);
+            return -1;
+        }
+    }
+
+    bool coresOk = finalizarCores(&cores, bloco, m);
+    liberarTabelaCores(&cores);
+    return coresOk ? m : -1;
+}
+
+/* Ordenação externa de 'entrada' (formato do runcodes) com cerca de 'orcamento' bytes de heap, no mínimo
+EXTERNO_ORCAMENTO_MINIMO; temporários em 'dirTemp' (NULL: tmpfile()). Devolve 0 ou -1 em erro. */
+int ordenacaoExterna(FILE *entrada, size_t orcamento, const char *dirTemp) {
+    if (orcamento < EXTERNO_ORCAMENTO_MINIMO) {
+        fprintf(stderr, "Orçamento do --externo abaixo do mínimo de %zu bytes.\n", (size_t)EXTERNO_ORCAMENTO_MINIMO);
+        return -1;
+    }
+
+    LeitorFluxo l = { entrada, (char *)malloc(EXTERNO_LEITURA), 0, 0, false };
+    if (!l.buf)
+        return -1;
+
+    bool ok;
+    int n = 0;
+    if (!lerCabecalhoFluxo(&l, &n)) {
+        free(l.buf);
+        return -1;
+    }
+
+    size_t porBloco = (orcamento - EXTERNO_LEITURA) / EXTERNO_BYTES_POR_REGISTRO; // >= EXTERNO_BLOCO_MINIMO
+    int capacidade = porBloco > (size_t)n ? (n > 0 ? n : 1) : (int)porBloco;
+    Brinquedo *bloco = (Brinquedo *)malloc(capacidade * sizeof(Brinquedo));
+    uint32_t *ordem = (uint32_t *)malloc(capacidade * sizeof(uint32_t));
+    SaidaIds *ids = (SaidaIds *)malloc(sizeof(SaidaIds));
+    FILE *arquivo = NULL;
+    Corrida *corridas = NULL;
+    int numeroCorridas = 0, capacidadeCorridas = 0, lidos = 0;
+    ok = bloco && ordem && ids;
+    if (ids)
+        ids->usado = 0;
+
+    // fase 1: blocos ordenados viram corridas (ou, se a entrada couber num bloco só, já saem como ids)
+    while (ok && lidos < n) {
+        int pedir = n - lidos < capacidade ? n - lidos : capacidade;
+        int m = lerBlocoFluxo(&l, bloco, pedir, lidos);
+        if (m < 0 || !ordenarIndices(bloco, m, ordem)) {
+            ok = false;
+            break;
+        }
+        lidos += m;
+        bool ultimo = lidos == n || m < pedir; // m < pedir: registro malformado encerra a leitura
+
+        if (ultimo && numeroCorridas == 0) {
+            for (int i = 0; i < m; i++)
+                escreverId(ids, bloco[ordem[i]].id);
+            break;
+        }
+
+        if (!arquivo && !(arquivo = criarTemporario(dirTemp))) {
+            fprintf(stderr, "Falha ao criar arquivo temporário.\n");
+            ok = false;
+            break;
+        }
+        if (numeroCorridas == capacidadeCorridas) {
+            capacidadeCorridas = capacidadeCorridas ? 2 * capacidadeCorridas : 16;
+            Corrida *maior = (Corrida *)realloc(corridas, capacidadeCorridas * sizeof(Corrida));
+            if (!maior) {
+                ok = false;
+                break;
+            }
+            corridas = maior;
+        }
+        long long inicio = numeroCorridas ? corridas[numeroCorridas - 1].inicio + corridas[numeroCorridas - 1].quantidade : 0;
+        corridas[numeroCorridas++] = (Corrida){ inicio, m };
+        ok = gravarCorrida(arquivo, bloco, ordem, m);
+        if (ultimo)
+            break;
+    }
+    free(l.buf);
+    free(bloco);
+    free(ordem);
+
+    // fase 2: passadas de intercalação até sobrarem corridas que caibam num buffer de EXTERNO_BUFFER_MINIMO cada
+    int maxCorridas = (int)(orcamento / EXTERNO_BUFFER_MINIMO) - 1;
+    if (maxCorridas < 2)
+        maxCorridas = 2;
+    while (ok && numeroCorridas > maxCorridas) {
+        FILE *proximo = criarTemporario(dirTemp);
+        if (!proximo) {
+            fprintf(stderr, "Falha ao criar arquivo temporário.\n");
+            ok = false;
+            break;
+        }
+
+        int novas = 0;
+        long long escritos = 0;
+        for (int g = 0; ok && g < numeroCorridas; g += maxCorridas) {
+            int k = numeroCorridas - g < maxCorridas ? numeroCorridas - g : maxCorridas;
+            long long total = 0;
+            for (int i = 0; i < k; i++)
+                total += corridas[g + i].quantidade;
+            ok = intercalarCorridas(arquivo, corridas + g, k, orcamento, proximo, NULL);
+            corridas[novas++] = (Corrida){ escritos, total };
+            escritos += total;
+        }
+        fclose(arquivo);
+        arquivo = proximo;
+        numeroCorridas = novas;
+    }
+
+    if (ok && numeroCorridas > 0) {
+        ok = fflush(arquivo) == 0 && intercalarCorridas(arquivo, corridas, numeroCorridas, orcamento, NULL, ids);
+        if (!ok)
+            fprintf(stderr, "Falha na intercalação das corridas (disco cheio?).\n");
+    }
+
+    if (ok) {
+        fwrite(ids->buf, 1, ids->usado, stdout);
+        printf("\n");
+    }
+    if (arquivo)
+        fclose(arquivo);
+    free(corridas);
+    free(ids);
+    return ok ? 0 : -1;
+}
+
+/* --top K em fluxo: só os K primeiros ids da ordem (cor, comprimento, nota, id), com memória O(K) e tempo
+O(n log K). Um heap de máximo com os K menores registros vistos até agora (no formato das corridas do
+--externo, já que os postos de cor não existem antes do fim da leitura) é mantido durante a leitura; um
+registro novo só entra se for menor que a raiz, o que logo vira raro. No fim, o heap é ordenado no lugar. */
+static void peneirarTopo(RegistroCorrida *heap, int i, int n) {
+    RegistroCorrida x = heap[i];
+    for (;;) {
+        int filho = 2 * i + 1;
+        if (filho >= n)
+            break;
+        if (filho + 1 < n && registroMenor(&heap[filho], &heap[filho + 1]))
+            filho++;
+        if (!registroMenor(&x, &heap[filho]))
+            break;
+        heap[i] = heap[filho];
+        i = filho;
+    }
+    heap[i] = x;
+}
+
+int topoEmFluxo(FILE *entrada, int k) {
+    LeitorFluxo l = { entrada, (char *)malloc(EXTERNO_LEITURA), 0, 0, false };
+    SaidaIds *ids = (SaidaIds *)malloc(sizeof(SaidaIds));
+    int n = 0;
+    if (!l.buf || !ids || !lerCabecalhoFluxo(&l, &n)) {
+        free(l.buf);
+        free(ids);
+        return -1;
+    }
+    if (k > n)
+        k = n;
+
+    RegistroCorrida *heap = (RegistroCorrida *)malloc((k > 0 ? k : 1) * sizeof(RegistroCorrida));
+    if (!heap) {
+        free(l.buf);
+        free(ids);
+        return -1;
+    }
+
+    int tamanho = 0;
+    Brinquedo b;
+    RegistroCorrida r;
+    for (int i = 0; i < n && k > 0 && lerBrinquedoFluxo(&l, &b); i++) {
+        b.id = i;
+        montarRegistro(&r, &b);
+        if (tamanho < k) { // enchendo: sobe o novo registro
+            int j = tamanho++;
+            while (j > 0 && registroMenor(&heap[(j - 1) / 2], &r)) {
+                heap[j] = heap[(j - 1) / 2];
+                j = (j - 1) / 2;
+            }
+            heap[j] = r;
+        }
+        else if (registroMenor(&r, &heap[0])) {
+            heap[0] = r;
+            peneirarTopo(heap, 0, tamanho);
+        }
+    }
+
+    for (int fim = tamanho - 1; fim > 0; fim--) { // heapsort: o maior vai para o fim
+        RegistroCorrida t = heap[0];
+        heap[0] = heap[fim];
+        heap[fim] = t;
+        peneirarTopo(heap, 0, fim);
+    }
+
+    ids->usado = 0;
+    for (int i = 0; i < tamanho; i++)
+        escreverId(ids, heap[i].id);
+    fwrite(ids->buf, 1, ids->usado, stdout);
+    printf("\n");
+
+    free(heap);
+    free(l.buf);
+    free(ids);
+    return 0;
+}
+
+/* --batch: primeiro todos os arquivos da lista são lidos (em ordem), depois cada par (arquivo, algoritmo) vira
+uma tarefa. Com --jobs N, N workers (cada um fixado num núcleo próprio; N não passa dos núcleos permitidos)
+pegam tarefas de um contador compartilhado, das mais caras para as mais baratas (quadráticos primeiro), e gravam
+o resultado no slot da tarefa. As do método paralelo, cronometradas em tempo de parede e com threads próprios,
+rodam sozinhas depois que o pool esvazia. O CSV só é impresso no fim, na ordem da lista, então a saída não
+depende do escalonamento. */
+typedef struct {
+    char caminho[1024];
+    Brinquedo *orig;
+    int n;
+    double tempoLeitura;
+} ArquivoBatch;
+
+typedef struct {
+    int arquivo, algoritmo;
+    int threads;      // método paralelo: número de threads (0: um por núcleo)
+    double custo;     // estimativa usada só para a ordem de despacho
+    double tempo;     // com --repeat: média das repetições
+    double *amostras; // 'repeticoes' tempos medidos (após o aquecimento)
+    double minimo, mediana, desvio, ic95;
+#ifdef CONTADORES_HW
+    long long comparacoes, trocas;
+    LeituraHW hw;
+#endif
+} TarefaBatch;
+
+typedef struct {
+    ArquivoBatch *arquivos;
+    TarefaBatch *tarefas;
+    int repeticoes, aquecimento; // --repeat K --warmup W
+    const int *threads;          // --threads a,b,...: uma tarefa do método paralelo para cada contagem
+    int numeroThreads;
+    int *despacho;   // índices das tarefas, em ordem de custo decrescente
+    int numeroTarefas;
+    int fimPool;     // despacho[0..fimPool) vai para os workers; o resto (método paralelo) roda depois, sozinho
+    int proxima;     // próxima posição de 'despacho' (protegida por trava)
+#ifndef _WIN32
+    pthread_mutex_t trava;
+#endif
+} FilaBatch;
+
+typedef struct {
+    FilaBatch *fila;
+    int nucleo;      // -1: não fixar
+} WorkerBatch;
+
+static int compararDoubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// t de Student bicaudal 95% para gl = 1..30 (acima disso, 1.96)
+static double tStudent95(int gl) {
+    static const double t[] = { 0, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+    return gl >= 1 && gl <= 30 ? t[gl] : 1.96;
+}
+
+/* W execuções de aquecimento (descartadas) e K medidas; cada uma ordena uma cópia nova feita fora da região
+cronometrada (executarAlgoritmoCopia). Estatísticas: mínimo, mediana, média, desvio amostral e meia-largura
+do intervalo de 95% da média (t * s / sqrt(K)). */
+static void executarTarefaBatch(FilaBatch *fila, TarefaBatch *t) {
+    const ArquivoBatch *arq = &fila->arquivos[t->arquivo];
+    int k = fila->repeticoes;
+    double descartado;
+
+    for (int r = 0; r < fila->aquecimento; r++)
+        executarAlgoritmoCopia(arq->orig, arq->n, t->algoritmo, t->threads, &descartado);
+    for (int r = 0; r < k; r++)
+        executarAlgoritmoCopia(arq->orig, arq->n, t->algoritmo, t->threads, &t->amostras[r]);
+
+    double soma = 0.0, quadrados = 0.0;
+    for (int r = 0; r < k; r++)
+        soma += t->amostras[r];
+    t->tempo = soma / k;
+    for (int r = 0; r < k; r++)
+        quadrados += (t->amostras[r] - t->tempo) * (t->amostras[r] - t->tempo);
+    t->desvio = k > 1 ? sqrt(quadrados / (k - 1)) : 0.0;
+    t->ic95 = k > 1 ? tStudent95(k - 1) * t->desvio / sqrt((double)k) : 0.0;
+
+    double *ordenadas = (double *)malloc(k * sizeof(double));
+    if (ordenadas) {
+        memcpy(ordenadas, t->amostras, k * sizeof(double));
+        qsort(ordenadas, k, sizeof(double), compararDoubles);
+        t->minimo = ordenadas[0];
+        t->mediana = k % 2 ? ordenadas[k / 2] : 0.5 * (ordenadas[k / 2 - 1] + ordenadas[k / 2]);
+        free(ordenadas);
+    }
+    else
+        t->minimo = t->mediana = t->tempo;
+#ifdef CONTADORES_HW
+    t->comparacoes = contagemComparacoes; // da última repetição
+    t->trocas = contagemTrocas;
+    t->hw = ultimaLeituraHW;
+#endif
+}
+
+static const char *nomesAlgoritmos[NUMERO_ALGORITMOS + 1] = { "", "bubble", "insertion", "merge", "quick", "radix",
+                                                               "indices", "soa", "timsort", "introsort", "paralelo" };
+
+#ifdef CONTADORES_HW
+/* Só são contagens completas quando o método compara apenas por compararBrinquedos (comparações) e move registros
+apenas por capitaoGinyu (trocas); nos demais a coluna sai como NA em vez de um zero enganoso: radix, índices e
+SoA comparam chaves próprias, inserção/merge/timsort/introsort também copiam registros, e no paralelo as
+intercalações contam nos threads de trabalho. */
+static const bool contaComparacoes[NUMERO_ALGORITMOS + 1] = { false, true, true, true, true, false, false, false,
+                                                              true, true, false };
+static const bool contaTrocas[NUMERO_ALGORITMOS + 1] = { false, true, false, false, true, false, false, false,
+                                                         false, false, false };
+
+static void imprimirContagem(FILE *f, long long valor, bool instrumentado) {
+    if (instrumentado)
+        fprintf(f, ",%lld", valor);
+    else
+        fprintf(f, ",NA");
+}
+#endif
+
+/* Rótulo da tarefa no CSV/tabelas: "alg10" (e "paralelo") com o padrão de um thread por núcleo; com --threads,
+"alg10t4" (e "paralelo_t4"), para comparar a escala de 1 a N threads. */
+static void rotuloTarefa(char *dst, size_t tamanho, const TarefaBatch *t, bool nome) {
+    if (nome)
+        snprintf(dst, tamanho, "%s", nomesAlgoritmos[t->algoritmo]);
+    else
+        snprintf(dst, tamanho, "alg%d", t->algoritmo);
+
+    if (t->threads > 0) {
+        size_t usado = strlen(dst);
+        snprintf(dst + usado, tamanho - usado, nome ? "_t%d" : "t%d", t->threads);
+    }
+}
+
+// Coluna da tabela pelo nome do arquivo (como gerado por inputGenerator.py): 0 best, 1 average, 2 worst, -1 outro
+static int colunaDoArquivo(const char *caminho) {
+    const char *base = caminho;
+    for (const char *c = caminho; *c; c++)
+        if (*c == '/' || *c == '\\')
+            base = c + 1;
+
+    if (strstr(base, "best"))
+        return 0;
+    if (strstr(base, "average"))
+        return 1;
+    if (strstr(base, "worst"))
+        return 2;
+    return -1;
+}
+
+// Contagens de threads em que o método a roda: a lista do --threads para o paralelo, {0} para os demais
+static int variantesDoMetodo(const FilaBatch *fila, int a, const int **threads) {
+    static const int padrao = 0;
+    if (a == METODO_PARALELO && fila->numeroThreads > 0) {
+        *threads = fila->threads;
+        return fila->numeroThreads;
+    }
+    *threads = &padrao;
+    return 1;
+}
+
+/* Regenera <dir>/<algoritmo>.txt no formato de bubble.txt/insertion.txt: uma linha por qtd (n do arquivo),
+colunas melhor/medio/pior (arquivos best/average/worst), cada célula "media+-ic95". */
+static void escreverTabela(const char *dir, const FilaBatch *fila, int numeroArquivos, int a, int threads) {
+    TarefaBatch modelo = { .algoritmo = a, .threads = threads };
+    char nome[64], caminho[1200];
+    rotuloTarefa(nome, sizeof(nome), &modelo, true);
+    snprintf(caminho, sizeof(caminho), "%s/%s.txt", dir, nome);
+
+    FILE *out = fopen(caminho, "w");
+    if (!out) {
+        fprintf(stderr, "Falha ao criar tabela: %s\n", caminho);
+        return;
+    }
+    fprintf(out, "qtd, melhor, medio, pior\n");
+
+    // tamanhos distintos em ordem crescente (poucos arquivos: seleção simples)
+    int anterior = -1;
+    for (;;) {
+        int qtd = -1;
+        for (int f = 0; f < numeroArquivos; f++)
+            if (colunaDoArquivo(fila->arquivos[f].caminho) >= 0 && fila->arquivos[f].n > anterior &&
+                (qtd < 0 || fila->arquivos[f].n < qtd))
+                qtd = fila->arquivos[f].n;
+        if (qtd < 0)
+            break;
+
+        const TarefaBatch *celula[3] = { NULL, NULL, NULL };
+        for (int t = 0; t < fila->numeroTarefas; t++) {
+            const TarefaBatch *tarefa = &fila->tarefas[t];
+            const ArquivoBatch *arq = &fila->arquivos[tarefa->arquivo];
+            int coluna = colunaDoArquivo(arq->caminho);
+            if (tarefa->algoritmo == a && tarefa->threads == threads && arq->n == qtd && coluna >= 0 &&
+                !celula[coluna])
+                celula[coluna] = tarefa;
+        }
+
+        fprintf(out, "%d", qtd);
+        for (int c = 0; c < 3; c++) {
+            if (celula[c])
+                fprintf(out, ", %.6f+-%.6f", celula[c]->tempo, celula[c]->ic95);
+            else
+                fprintf(out, ", -");
+        }
+        fprintf(out, "\n");
+        anterior = qtd;
+    }
+    fclose(out);
+}
+
+static void escreverTabelas(const char *dir, const FilaBatch *fila, int numeroArquivos, const bool *runAlgo) {
+    for (int a = 1; a <= NUMERO_ALGORITMOS; a++) {
+        if (!runAlgo[a]) continue;
+
+        const int *threads;
+        int variantes = variantesDoMetodo(fila, a, &threads);
+        for (int v = 0; v < variantes; v++)
+            escreverTabela(dir, fila, numeroArquivos, a, threads[v]);
+    }
+}
+
+static void *workerBatch(void *arg) {
+    WorkerBatch *w = (WorkerBatch *)arg;
+    FilaBatch *fila = w->fila;
+
+#if defined(__linux__)
+    if (w->nucleo >= 0) {
+        cpu_set_t conjunto;
+        CPU_ZERO(&conjunto);
+        CPU_SET(w->nucleo, &conjunto);
+        pthread_setaffinity_np(pthread_self(), sizeof(conjunto), &conjunto);
+    }
+#endif
+
+    for (;;) {
+        int posicao;
+#ifndef _WIN32
+        pthread_mutex_lock(&fila->trava);
+#endif
+        posicao = fila->proxima++;
+#ifndef _WIN32
+        pthread_mutex_unlock(&fila->trava);
+#endif
+        if (posicao >= fila->fimPool)
+            break;
+        executarTarefaBatch(fila, &fila->tarefas[fila->despacho[posicao]]);
+    }
+    return NULL;
+}
+
+static TarefaBatch *tarefasEmOrdenacao; // contexto do qsort do despacho
+
+static int compararCustoTarefas(const void *a, const void *b) {
+    const TarefaBatch *x = &tarefasEmOrdenacao[*(const int *)a], *y = &tarefasEmOrdenacao[*(const int *)b];
+    bool px = x->algoritmo == METODO_PARALELO, py = y->algoritmo == METODO_PARALELO;
+    if (px != py)
+        return px ? 1 : -1; // método paralelo no fim do despacho, fora do pool
+    if (x->custo != y->custo)
+        return x->custo < y->custo ? 1 : -1;
+    return *(const int *)a - *(const int *)b;
+}
+
+static int executarBatch(const char *listaPath, const bool *runAlgo, int jobs, int repeticoes, int aquecimento,
+                         const int *threads, int numeroThreads, const char *dirTabelas) {
+    FILE *lf = fopen(listaPath, "r");
+    if (!lf) {
+        fprintf(stderr, "Erro ao abrir lista de testes: %s\n", listaPath);
+        return -1;
+    }
+
+    int numeroArquivos = 0, capacidade = 8;
+    ArquivoBatch *arquivos = (ArquivoBatch *)malloc(capacidade * sizeof(ArquivoBatch));
+    if (!arquivos) {
+        fclose(lf);
+        return -1;
+    }
+
+    char pathbuf[1024];
+    while (fgets(pathbuf, sizeof(pathbuf), lf)) {
+        // trim newline/carriage
+        size_t L = strlen(pathbuf);
+        while (L > 0 && (pathbuf[L-1] == '\n' || pathbuf[L-1] == '\r')) { pathbuf[--L] = '\0'; }
+        if (L == 0) continue;
+
+        FILE *tf = fopen(pathbuf, "rb");
+        if (!tf) {
+            fprintf(stderr, "Falha ao abrir arquivo de teste: %s\n", pathbuf);
+            continue;
+        }
+
+        // leitura (mmap + tokenização no buffer) medida à parte da ordenação
+        int numeroBrinquedos = 0;
+        double inicioLeitura = tempoCpuThread();
+        Brinquedo *orig = carregarBrinquedos(tf, &numeroBrinquedos, NULL);
+        double tempoLeitura = tempoCpuThread() - inicioLeitura;
+        fclose(tf);
+
+        if (!orig) {
+            fprintf(stderr, "Formato inválido ou falha de memória em: %s\n", pathbuf);
+            continue;
+        }
+
+        if (numeroArquivos == capacidade) {
+            ArquivoBatch *maior = (ArquivoBatch *)realloc(arquivos, 2 * capacidade * sizeof(ArquivoBatch));
+            if (!maior) {
+                free(orig);
+                break;
+            }
+            arquivos = maior;
+            capacidade *= 2;
+        }
+
+        ArquivoBatch *arq = &arquivos[numeroArquivos++];
+        strcpy(arq->caminho, pathbuf);
+        arq->orig = orig;
+        arq->n = numeroBrinquedos;
+        arq->tempoLeitura = tempoLeitura;
+    }
+    fclose(lf);
+
+    // uma tarefa por (arquivo, algoritmo[, threads]), na ordem em que o CSV será impresso
+    FilaBatch fila;
+    fila.threads = threads;
+    fila.numeroThreads = numeroThreads;
+
+    int numeroAlgoritmos = 0;
+    for (int a = 1; a <= NUMERO_ALGORITMOS; a++) {
+        const int *variantes;
+        if (runAlgo[a])
+            numeroAlgoritmos += variantesDoMetodo(&fila, a, &variantes);
+    }
+
+    fila.arquivos = arquivos;
+    fila.numeroTarefas = numeroArquivos * numeroAlgoritmos;
+    fila.fimPool = fila.numeroTarefas;
+    fila.proxima = 0;
+    fila.repeticoes = repeticoes;
+    fila.aquecimento = aquecimento;
+    fila.tarefas = (TarefaBatch *)calloc(fila.numeroTarefas > 0 ? fila.numeroTarefas : 1, sizeof(TarefaBatch));
+    fila.despacho = (int *)malloc((fila.numeroTarefas > 0 ? fila.numeroTarefas : 1) * sizeof(int));
+    double *amostras = (double *)malloc((fila.numeroTarefas > 0 ? fila.numeroTarefas : 1) * repeticoes * sizeof(double));
+    if (!fila.tarefas || !fila.despacho || !amostras) {
+        fprintf(stderr, "Falha ao alocar as tarefas do batch.\n");
+        free(fila.tarefas);
+        free(fila.despacho);
+        free(amostras);
+        for (int f = 0; f < numeroArquivos; f++)
+            free(arquivos[f].orig);
+        free(arquivos);
+        return -1;
+    }
+
+    int k = 0;
+    for (int f = 0; f < numeroArquivos; f++) {
+        double n = arquivos[f].n > 1 ? (double)arquivos[f].n : 1.0;
+        double log2n = 1.0;
+        for (double m = n; m >= 2.0; m /= 2.0)
+            log2n += 1.0;
+        double nlogn = n * log2n;
+        for (int a = 1; a <= NUMERO_ALGORITMOS; a++) {
+            if (!runAlgo[a]) continue;
+            const int *variantes;
+            int numeroVariantes = variantesDoMetodo(&fila, a, &variantes);
+            for (int v = 0; v < numeroVariantes; v++) {
+                fila.tarefas[k].arquivo = f;
+                fila.tarefas[k].algoritmo = a;
+                fila.tarefas[k].threads = variantes[v];
+                fila.tarefas[k].custo = (a == 1 || a == 2 || a == 4) ? n * n : nlogn; // quick: pivo fixo, O(n^2) em entrada ordenada
+                fila.tarefas[k].amostras = &amostras[(size_t)k * repeticoes];
+                fila.despacho[k] = k;
+                k++;
+            }
+        }
+    }
+    tarefasEmOrdenacao = fila.tarefas;
+    qsort(fila.despacho, fila.numeroTarefas, sizeof(int), compararCustoTarefas);
+
+    fila.fimPool = 0;
+    for (int t = 0; t < fila.numeroTarefas; t++)
+        fila.fimPool += fila.tarefas[t].algoritmo != METODO_PARALELO;
+
+    // núcleos permitidos a este processo (respeita taskset/cgroups); o worker w fica no w-ésimo deles
+    int nucleos[1024], numeroNucleos = 0;
+#if defined(__linux__)
+    cpu_set_t permitidos;
+    if (sched_getaffinity(0, sizeof(permitidos), &permitidos) == 0)
+        for (int c = 0; c < CPU_SETSIZE && numeroNucleos < 1024; c++)
+            if (CPU_ISSET(c, &permitidos))
+                nucleos[numeroNucleos++] = c;
+#endif
+
+    // um worker por núcleo, no máximo: dois no mesmo núcleo dividiriam o tempo de CPU e a cache
+    if (numeroNucleos > 0 && jobs > numeroNucleos)
+        jobs = numeroNucleos;
+    if (jobs > fila.fimPool)
+        jobs = fila.fimPool > 0 ? fila.fimPool : 1;
+
+#ifndef _WIN32
+    if (jobs > 1) {
+
+        pthread_t *threads = (pthread_t *)malloc(jobs * sizeof(pthread_t));
+        WorkerBatch *workers = (WorkerBatch *)malloc(jobs * sizeof(WorkerBatch));
+        WorkerBatch principal = { &fila, numeroNucleos > 0 ? nucleos[0] : -1 };
+        pthread_mutex_init(&fila.trava, NULL);
+
+        // a thread principal é o worker 0; se faltar memória ou uma criação falhar, ela faz o resto sozinha
+        int criadas = 0;
+        if (threads && workers) {
+            for (int w = 1; w < jobs; w++) {
+                workers[w].fila = &fila;
+                workers[w].nucleo = numeroNucleos > 0 ? nucleos[w] : -1;
+                if (pthread_create(&threads[w], NULL, workerBatch, &workers[w]) != 0)
+                    break;
+                criadas++;
+            }
+        }
+
+        workerBatch(&principal);
+        for (int w = 1; w <= criadas; w++)
+            pthread_join(threads[w], NULL);
+
+        pthread_mutex_destroy(&fila.trava);
+        free(threads);
+        free(workers);
+
+        // a thread principal ficou fixada em nucleos[0]; os threads do método paralelo herdariam essa máscara
+#if defined(__linux__)
+        if (numeroNucleos > 0)
+            pthread_setaffinity_np(pthread_self(), sizeof(permitidos), &permitidos);
+#endif
+        for (int p = fila.fimPool; p < fila.numeroTarefas; p++)
+            executarTarefaBatch(&fila, &fila.tarefas[fila.despacho[p]]);
+    }
+    else
+#endif
+    {
+        for (int t = 0; t < fila.numeroTarefas; t++)
+            executarTarefaBatch(&fila, &fila.tarefas[t]);
+    }
+
+    // CSV em stderr, na ordem da lista e dos algoritmos. Com --repeat K > 1 as colunas de tempo viram
+    // repeticoes,min,mediana,media,desvio,ic95 (meia-largura do intervalo de 95% da média)
+    if (repeticoes > 1) {
+        fprintf(stderr, "arquivo,alg,repeticoes,min,mediana,media,desvio,ic95");
+#ifdef CONTADORES_HW
+        fprintf(stderr, ",comparacoes,trocas,ciclos,instrucoes,branch_misses,l1d_misses,llc_misses,ipc");
+#endif
+        fprintf(stderr, "\n");
+    }
+
+    k = 0;
+    for (int f = 0; f < numeroArquivos; f++) {
+        // leitura: medida uma vez, nas mesmas colunas das tarefas (repeticoes = 1, desvio e ic95 zerados)
+        fprintf(stderr, "%s,leitura,", arquivos[f].caminho);
+        if (repeticoes > 1)
+            fprintf(stderr, "1,%.6f,%.6f,%.6f,0.000000,0.000000", arquivos[f].tempoLeitura, arquivos[f].tempoLeitura,
+                    arquivos[f].tempoLeitura);
+        else
+            fprintf(stderr, "%.6f", arquivos[f].tempoLeitura);
+#ifdef CONTADORES_HW
+        fprintf(stderr, ",NA,NA,NA,NA,NA,NA,NA,NA"); // contadores só existem para as tarefas
+#endif
+        fprintf(stderr, "\n");
+        for (int a = 0; a < numeroAlgoritmos; a++, k++) {
+            const TarefaBatch *t = &fila.tarefas[k];
+            char rotulo[64];
+            rotuloTarefa(rotulo, sizeof(rotulo), t, false);
+            fprintf(stderr, "%s,%s,", arquivos[f].caminho, rotulo);
+            if (repeticoes > 1)
+                fprintf(stderr, "%d,%.6f,%.6f,%.6f,%.6f,%.6f", repeticoes, t->minimo, t->mediana, t->tempo,
+                        t->desvio, t->ic95);
+            else
+                fprintf(stderr, "%.6f", t->tempo);
+#ifdef CONTADORES_HW
+            // colunas extras: comparacoes,trocas,ciclos,instrucoes,branch_misses,l1d_misses,llc_misses,ipc
+            imprimirContagem(stderr, t->comparacoes, contaComparacoes[t->algoritmo]);
+            imprimirContagem(stderr, t->trocas, contaTrocas[t->algoritmo]);
+            fprintf(stderr, ",");
+            contadores_imprimir_csv(stderr, &t->hw);
+#endif
+            fprintf(stderr, "\n");
+        }
+    }
+
+    if (dirTabelas)
+        escreverTabelas(dirTabelas, &fila, numeroArquivos, runAlgo);
+
+    for (int f = 0; f < numeroArquivos; f++)
+        free(arquivos[f].orig);
+    free(amostras);
+    free(fila.tarefas);
+    free(fila.despacho);
+    free(arquivos);
+    return 0;
+}
+
+// substitui a main original para suportar --batch sem quebrar o uso original
+int main(int argc, char *argv[]) {
+    // Modo batch: --batch <lista.txt> [all|1,2,...,NUMERO_ALGORITMOS] [--jobs N] [--repeat K] [--warmup W]
+    //             [--threads a,b,...] [--tabelas dir]
+    // CSV em stderr: "arquivo,leitura,tempo" por arquivo e "arquivo,algN,tempo" por algoritmo;
+    // --threads 1,2,4 roda o método paralelo (10) com cada contagem ("alg10t1", "alg10t2", ...; tempo de parede);
+    // --tabelas regenera dir/bubble.txt, dir/merge.txt, ... ("qtd, melhor, medio, pior") a partir de best/average/worst
+    // Compilação: gcc -O2 -pthread byron.c -o byron -lm
+    //             (introsort genérico: -DORDENACAO_GENERICA -I ../../../benchmark)
+    if (argc >= 3 && strcmp(argv[1], "--batch") == 0) {
+        const char *listaPath = argv[2];
+        const char *algosSpec = "all", *dirTabelas = NULL;
+        int jobs = 1, repeticoes = 1, aquecimento = 0;
+        int threads[32], numeroThreads = 0; // vazio: método paralelo com um thread por núcleo
+
+        for (int i = 3; i < argc; i++) {
+            if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+                jobs = atoi(argv[++i]);
+                if (jobs <= 0) { // 0: um worker por núcleo
+#ifndef _WIN32
+                    long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+                    jobs = nucleos > 0 ? (int)nucleos : 1;
+#else
+                    jobs = 1;
+#endif
+                }
+            }
+            else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc)
+                repeticoes = atoi(argv[++i]);
+            else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc)
+                aquecimento = atoi(argv[++i]);
+            else if (strcmp(argv[i], "--tabelas") == 0 && i + 1 < argc)
+                dirTabelas = argv[++i];
+            else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+                char specbuf[128];
+                strncpy(specbuf, argv[++i], sizeof(specbuf)-1);
+                specbuf[sizeof(specbuf)-1] = '\0';
+                for (char *tok = strtok(specbuf, ","); tok && numeroThreads < 32; tok = strtok(NULL, ",")) {
+                    threads[numeroThreads] = atoi(tok);
+                    if (threads[numeroThreads] < 1) {
+                        fprintf(stderr, "--threads espera contagens >= 1 (ex.: 1,2,4,8).\n");
+                        return -1;
+                    }
+                    numeroThreads++;
+                }
+            }
+            else
+                algosSpec = argv[i];
+        }
+
+        if (repeticoes < 1 || aquecimento < 0) {
+            fprintf(stderr, "--repeat deve ser >= 1 e --warmup >= 0.\n");
+            return -1;
+        }
+
+        // preparar lista de algoritmos a executar
+        bool runAlgo[NUMERO_ALGORITMOS + 1]; // index 1..NUMERO_ALGORITMOS (default all)
+        for (int i = 0; i <= NUMERO_ALGORITMOS; i++) runAlgo[i] = i >= 1;
+        if (strcmp(algosSpec, "all") != 0) {
+            // reset e parse simples "1,2" ou "2"
+            for (int i = 0; i <= NUMERO_ALGORITMOS; i++) runAlgo[i] = false;
+            char specbuf[128];
+            strncpy(specbuf, algosSpec, sizeof(specbuf)-1);
+            specbuf[sizeof(specbuf)-1] = '\0';
+            char *tok = strtok(specbuf, ",");
+            while (tok) {
+                int a = atoi(tok);
+                if (a >= 1 && a <= NUMERO_ALGORITMOS) runAlgo[a] = true;
+                tok = strtok(NULL, ",");
+            }
+        }
+
+        return executarBatch(listaPath, runAlgo, jobs, repeticoes, aquecimento, threads, numeroThreads, dirTabelas);
+    }
+
+    /* --top K [--residente] < entrada: só os K primeiros ids. Por padrão em fluxo (heap limitado, memória O(K));
+    com --residente a entrada é carregada inteira e o introselect separa os K menores. */
+    if (argc >= 3 && strcmp(argv[1], "--top") == 0) {
+        int k = atoi(argv[2]);
+        bool residente = argc >= 4 && strcmp(argv[3], "--residente") == 0;
+        if (k <= 0) {
+            fprintf(stderr, "--top espera K >= 1.\n");
+            return -1;
+        }
+
+        double inicio = tempoParede();
+        int status = 0;
+        if (residente) {
+            int numeroBrinquedos = 0;
+            Brinquedo *brinquedo = carregarBrinquedos(stdin, &numeroBrinquedos, NULL);
+            if (brinquedo == NULL)
+                return -1;
+            selecionarMenores(brinquedo, numeroBrinquedos, k);
+            for (int i = 0; i < k && i < numeroBrinquedos; i++)
+                printf("%d;", brinquedo[i].id);
+            printf("\n");
+            free(brinquedo);
+        }
+        else
+            status = topoEmFluxo(stdin, k);
+        fprintf(stderr, "Tempo (s): %.6f\n", tempoParede() - inicio);
+        return status;
+    }
+
+    // Modo externo: --externo <MB> [--tmp dir] < entrada; mesma entrada e saída do runcodes, memória limitada
+    if (argc >= 3 && strcmp(argv[1], "--externo") == 0) {
+        double megabytes = atof(argv[2]);
+        const char *dirTemp = NULL;
+        if (argc >= 5 && strcmp(argv[3], "--tmp") == 0)
+            dirTemp = argv[4];
+        if (megabytes * 1048576.0 < EXTERNO_ORCAMENTO_MINIMO) {
+            fprintf(stderr, "--externo espera o orçamento de memória em MB, no mínimo %.2f (ex.: --externo 64).\n",
+                    EXTERNO_ORCAMENTO_MINIMO / 1048576.0);
+            return -1;
+        }
+
+        double inicio = tempoParede();
+        int status = ordenacaoExterna(stdin, (size_t)(megabytes * 1048576.0), dirTemp);
+        fprintf(stderr, "Tempo (s): %.6f\n", tempoParede() - inicio);
+        return status;
+    }
+
+    int numeroBrinquedos = -1, metodoSelecionado = 0;
+
+    // leitura formatada dos dados, conforme o runcodes deseja (n, n linhas e o método), direto do buffer da entrada
+    Brinquedo *brinquedo = carregarBrinquedos(stdin, &numeroBrinquedos, &metodoSelecionado);
+    if (brinquedo == NULL)
+        return -1;
+
+    uint32_t *ordem = NULL; // método 6: só a ordem dos índices é calculada, os registros não se movem
+
+    // Medição de desempenho: inicia o relógio antes de executar o algoritmo. clock() soma a CPU de todas as
+    // threads, então o método paralelo é medido em tempo de parede, como em executarAlgoritmoCopia.
+    bool paralelo = metodoSelecionado == METODO_PARALELO;
+    double inicio_parede = paralelo ? tempoParede() : 0.0;
+    clock_t inicio_tempo = clock();
+
+    switch (metodoSelecionado) { // estrutura switch para o condicionamento dos casos de ordenação, no caso, o algoritmo em si.
+        case 1:
+            ordenacaoViaBubbleSort(brinquedo, numeroBrinquedos);
+            break;
+        
+        case 2:
+            ordenacaoViaInsertionSort(brinquedo, numeroBrinquedos);
+            break;
+        case 3:
+            ordenacaoViaMergeSort(brinquedo, 0, numeroBrinquedos - 1);
+            break;
+        case 4:
+            ordenacaoViaQuickSort(brinquedo, 0, numeroBrinquedos - 1);
+            break;
+        case 5:
+            ordenacaoViaRadixSort(brinquedo, numeroBrinquedos);
+            break;
+        case 6:
+            ordem = (uint32_t *)malloc((numeroBrinquedos > 0 ? numeroBrinquedos : 1) * sizeof(uint32_t));
+            if (ordem == NULL || !ordenarIndices(brinquedo, numeroBrinquedos, ordem)) {
+                free(ordem);
+                free(brinquedo);
+                return -1;
+            }
+            break;
+        case 7:
+            ordenacaoViaSoA(brinquedo, numeroBrinquedos);
+            break;
+        case 8:
+            ordenacaoViaTimSort(brinquedo, numeroBrinquedos);
+            break;
+        case 9:
+            ordenacaoViaIntroSort(brinquedo, numeroBrinquedos);
+            break;
+        case 10:
+            ordenacaoViaMergeSortParalelo(brinquedo, numeroBrinquedos, 0);
             break;
         default:
             // caso o método selecionado seja inválido, nenhuma ordenação é aplicada.
@@ -381,14 +2976,16 @@ int main(int argc, char *argv[]) {
 
     // Encerra a medição e calcula tempo decorrido (segundos).
     clock_t fim_tempo = clock();
-    double tempo_decorrido = (double)(fim_tempo - inicio_tempo) / (double)CLOCKS_PER_SEC;
+    double tempo_decorrido = paralelo ? tempoParede() - inicio_parede
+                                      : (double)(fim_tempo - inicio_tempo) / (double)CLOCKS_PER_SEC;
     // Imprime tempo em stderr para não poluir a saída padrão exigida pela plataforma de avaliação.
     fprintf(stderr, "Tempo (s): %.6f\n", tempo_decorrido);
     
     for (int i = 0; i < numeroBrinquedos; i++) // impressão padronizada dos id's associados à ordem de entrada dos brinquedos.
-        printf("%d;", brinquedo[i].id); // imprime os ids separados por ponto e vírgula (formato exigido pela plataforma).
+        printf("%d;", brinquedo[ordem ? (int)ordem[i] : i].id); // ids separados por ponto e vírgula (formato exigido pela plataforma); no método 6, gather pela ordem.
     
     printf("\n"); // quebra de linha posta por questão de conformidade à saída desejada pelo runcodes.
+    free(ordem);
     free(brinquedo);
 
     return 0;